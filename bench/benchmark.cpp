@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../book/market.hpp"
+#include "../book/order_book.hpp"
+#include "../book/pool.hpp"
+#include "../book/sharded_market.hpp"
+#include "flow_generator.hpp"
+
+// Reproducible engine benchmarks. Build with CMAKE_BUILD_TYPE=Release.
+//   akuna_bench [--scenario flow|cancel-depth|sharded|all] [--backend ladder|map|both] [--ops N]
+//               [--seed N] [--depth N] [--add W] [--ioc W] [--cancel W] [--modify W] [--mid P]
+//               [--spread S] [--symbols N] [--threads N]
+//
+// flow drives Market with synthetic order flow on top of a pre-built book and reports latency per
+// operation type. cancel-depth drives OrderBook directly and cancels orders out of a single price
+// level of growing depth, both through stored handles and through FindOnMarket. sharded spreads the
+// same flow over --symbols books and reports throughput with 1, 2, 4, ... up to --threads engine
+// threads.
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        akuna::bench::FlowConfig flow_{};
+        size_t                   ops_{1000000};
+        size_t                   symbols_{64};
+        size_t                   threads_{4};
+        std::string              scenario_{"all"};
+        std::string              backend_{"both"};
+    };
+
+    class Latencies {
+    public:
+        explicit Latencies(const char* name) : name_{name} {
+        }
+
+        auto Record(Clock::time_point start, Clock::time_point end) -> void {
+            samples_.push_back(static_cast<uint64_t>(std::chrono::nanoseconds(end - start).count()));
+        }
+
+        auto Report(std::string_view backend) -> void {
+            if (samples_.empty()) {
+                return;
+            }
+            uint64_t total = 0;
+            for (auto sample : samples_) {
+                total += sample;
+            }
+            std::sort(samples_.begin(), samples_.end());
+            std::printf("%-8.*s %-14s %10zu %10.2f %8lu %8lu %8lu %10lu\n", static_cast<int>(backend.size()),
+                        backend.data(), name_, samples_.size(),
+                        total == 0 ? 0.0 : static_cast<double>(samples_.size()) * 1e3 / static_cast<double>(total),
+                        Percentile(0.50), Percentile(0.99), Percentile(0.999), samples_.back());
+        }
+
+    private:
+        [[nodiscard]] auto Percentile(double rank) const -> uint64_t {
+            auto pos = static_cast<size_t>(rank * static_cast<double>(samples_.size()));
+            return samples_[std::min(pos, samples_.size() - 1)];
+        }
+
+        const char*           name_;
+        std::vector<uint64_t> samples_{};
+    };
+
+    auto PrintHeader() -> void {
+        std::printf("%-8s %-14s %10s %10s %8s %8s %8s %10s\n", "backend", "operation", "count", "Mops/s", "p50ns",
+                    "p99ns", "p99.9ns", "maxns");
+    }
+
+    template <template <typename, typename> class SideT>
+    auto RunFlow(const Options& options, std::string_view backend) -> void {
+        using MarketT = akuna::me::BasicMarket<SideT>;
+
+        auto                       market = std::make_unique<MarketT>();
+        akuna::bench::FlowGenerator flow{options.flow_};
+        akuna::book::Command       command;
+        for (size_t i = 0; i < options.flow_.depth_ * 2; ++i) {
+            flow.Seed(command);
+            market->Apply(command);
+        }
+
+        Latencies add{"add"};
+        Latencies ioc{"ioc"};
+        Latencies cancel{"cancel"};
+        Latencies modify{"modify"};
+        auto      is_live = [&market](akuna::book::OrderId id) { return market->Contains(id); };
+        auto      begin   = Clock::now();
+        for (size_t i = 0; i < options.ops_; ++i) {
+            flow.Next(command, is_live);
+            auto start = Clock::now();
+            market->Apply(command);
+            auto end = Clock::now();
+            switch (command.msg_type_) {
+                case 'A':
+                    (command.ioc_ ? ioc : add).Record(start, end);
+                    break;
+                case 'M':
+                    modify.Record(start, end);
+                    break;
+                case 'X':
+                    cancel.Record(start, end);
+                    break;
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        add.Report(backend);
+        ioc.Report(backend);
+        cancel.Report(backend);
+        modify.Report(backend);
+        std::printf("%-8.*s %-14s %10zu %10.2f  (wall clock, including generation)\n",
+                    static_cast<int>(backend.size()), backend.data(), "all", options.ops_,
+                    static_cast<double>(options.ops_) / elapsed / 1e6);
+    }
+
+    template <template <typename, typename> class SideT>
+    auto RunCancelDepth(const Options& options, std::string_view backend) -> void {
+        using OrderPool = akuna::book::Pool<akuna::book::Order>;
+        using OrderPtr  = OrderPool::Ptr;
+        using OrderBook = akuna::book::OrderBook<OrderPtr, SideT, akuna::book::NullListener>;
+
+        struct Resting {
+            OrderPtr                    order_{};
+            typename OrderBook::Handle handle_{};
+        };
+
+        constexpr akuna::book::Price PRICE{100};
+        constexpr size_t             SAMPLES{20000};
+
+        for (size_t depth : {10, 100, 1000, 10000}) {
+            for (bool use_handle : {true, false}) {
+                OrderPool            pool;
+                OrderBook            book;
+                std::vector<Resting> resting(depth);
+                std::mt19937_64      random{options.flow_.seed_};
+                akuna::book::OrderId next_id = 0;
+                auto                 rest    = [&](Resting& slot) {
+                    slot.order_ = pool.Create(next_id++, std::string_view{}, false, 10, PRICE);
+                    [[maybe_unused]] bool matched =
+                            book.Add(slot.order_, akuna::book::OrderCondition::OC_NO_CONDITIONS, slot.handle_);
+                };
+                for (auto& slot : resting) {
+                    rest(slot);
+                }
+
+                std::string name = std::string(use_handle ? "handle@" : "scan@") + std::to_string(depth);
+                Latencies   cancel{name.c_str()};
+                for (size_t i = 0; i < SAMPLES; ++i) {
+                    Resting& slot  = resting[random() % depth];
+                    auto     start = Clock::now();
+                    if (use_handle) {
+                        book.Cancel(slot.order_, slot.handle_);
+                    } else {
+                        book.Cancel(slot.order_);
+                    }
+                    cancel.Record(start, Clock::now());
+                    rest(slot);
+                }
+                cancel.Report(backend);
+            }
+        }
+    }
+
+    template <template <typename, typename> class SideT>
+    auto RunSharded(const Options& options, std::string_view backend) -> void {
+        // Both sides of the seeded book must land on every symbol, and seed ids alternate sides.
+        auto symbol_of = [&options](akuna::book::OrderId id) { return (id >> 1) % options.symbols_; };
+
+        // Commands are generated up front so that only routing and matching are timed. Liveness is
+        // not known on this thread, so cancels and modifies may name orders that are already gone.
+        akuna::bench::FlowGenerator        flow{options.flow_};
+        std::vector<akuna::book::Command> commands;
+        akuna::book::Command               command;
+        for (size_t i = 0; i < options.flow_.depth_ * 2 * options.symbols_; ++i) {
+            flow.Seed(command);
+            command.symbol_ = symbol_of(command.order_id_);
+            commands.push_back(command);
+        }
+        size_t seeded = commands.size();
+        for (size_t i = 0; i < options.ops_; ++i) {
+            flow.Next(command, [](akuna::book::OrderId) { return true; });
+            command.symbol_ = symbol_of(command.order_id_);
+            commands.push_back(command);
+        }
+
+        for (size_t shards = 1; shards <= options.threads_; shards *= 2) {
+            akuna::me::ShardConfig config;
+            config.shards_ = shards;
+            akuna::me::BasicShardedMarket<SideT> market{config};
+            for (size_t i = 0; i < seeded; ++i) {
+                market.Submit(commands[i]);
+            }
+            market.Sync();
+
+            auto begin = Clock::now();
+            for (size_t i = seeded; i < commands.size(); ++i) {
+                market.Submit(commands[i]);
+            }
+            market.Sync();
+            auto elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+            std::string name = "shards@" + std::to_string(shards);
+            std::printf("%-8.*s %-14s %10zu %10.2f  (wall clock, %zu symbols)\n", static_cast<int>(backend.size()),
+                        backend.data(), name.c_str(), options.ops_, static_cast<double>(options.ops_) / elapsed / 1e6,
+                        options.symbols_);
+        }
+    }
+
+    template <template <typename, typename> class SideT>
+    auto Run(const Options& options, std::string_view backend) -> void {
+        if (options.scenario_ == "flow" || options.scenario_ == "all") {
+            RunFlow<SideT>(options, backend);
+        }
+        if (options.scenario_ == "cancel-depth" || options.scenario_ == "all") {
+            RunCancelDepth<SideT>(options, backend);
+        }
+        if (options.scenario_ == "sharded" || options.scenario_ == "all") {
+            RunSharded<SideT>(options, backend);
+        }
+    }
+
+    auto Parse(int32_t argc, char** argv, Options& options) -> bool {
+        for (int32_t i = 1; i + 1 < argc; i += 2) {
+            std::string_view key{argv[i]};
+            const char*      value = argv[i + 1];
+            if (key == "--scenario") {
+                options.scenario_ = value;
+            } else if (key == "--backend") {
+                options.backend_ = value;
+            } else if (key == "--ops") {
+                options.ops_ = std::strtoull(value, nullptr, 10);
+            } else if (key == "--seed") {
+                options.flow_.seed_ = std::strtoull(value, nullptr, 10);
+            } else if (key == "--depth") {
+                options.flow_.depth_ = std::strtoull(value, nullptr, 10);
+            } else if (key == "--add") {
+                options.flow_.add_ = std::strtod(value, nullptr);
+            } else if (key == "--ioc") {
+                options.flow_.ioc_ = std::strtod(value, nullptr);
+            } else if (key == "--cancel") {
+                options.flow_.cancel_ = std::strtod(value, nullptr);
+            } else if (key == "--modify") {
+                options.flow_.modify_ = std::strtod(value, nullptr);
+            } else if (key == "--mid") {
+                options.flow_.mid_ = std::strtoull(value, nullptr, 10);
+            } else if (key == "--spread") {
+                options.flow_.spread_ = std::strtod(value, nullptr);
+            } else if (key == "--symbols") {
+                options.symbols_ = std::max<size_t>(1, std::strtoull(value, nullptr, 10));
+            } else if (key == "--threads") {
+                options.threads_ = std::strtoull(value, nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1;
+    }
+}    // namespace
+
+int32_t main(int32_t argc, char** argv) {
+    Options options;
+    if (!Parse(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s [--scenario flow|cancel-depth|sharded|all] [--backend ladder|map|both] [--ops N]\n"
+                     "          [--seed N] [--depth N] [--add W] [--ioc W] [--cancel W] [--modify W] [--mid P]\n"
+                     "          [--spread S] [--symbols N] [--threads N]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    PrintHeader();
+    if (options.backend_ == "ladder" || options.backend_ == "both") {
+        Run<akuna::book::LadderSide>(options, "ladder");
+    }
+    if (options.backend_ == "map" || options.backend_ == "both") {
+        Run<akuna::book::MapSide>(options, "map");
+    }
+    return 0;
+}
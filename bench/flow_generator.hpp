@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../book/command.hpp"
+#include "../book/types.hpp"
+
+namespace akuna::bench {
+    struct FlowConfig {
+        uint64_t    seed_{42};
+        size_t      depth_{1000};    // resting orders per side placed before measuring
+        double      add_{0.50};      // relative weights of each operation
+        double      ioc_{0.10};
+        double      cancel_{0.25};
+        double      modify_{0.15};
+        book::Price mid_{10000};
+        double      spread_{20.0};    // standard deviation of prices around the mid, in ticks
+    };
+
+    // Seeded synthetic order flow. Limit prices are normally distributed around a fixed mid, so
+    // roughly half of the adds rest and half cross into the opposite side, while IOCs always lean
+    // aggressive. Cancels and modifies target ids this generator created; ids that have since left
+    // the book are pruned through the caller's liveness check.
+    class FlowGenerator {
+    public:
+        explicit FlowGenerator(const FlowConfig& config) : config_{config}, random_{config.seed_} {
+            double total = config.add_ + config.ioc_ + config.cancel_ + config.modify_;
+            add_         = config.add_ / total;
+            ioc_         = add_ + config.ioc_ / total;
+            cancel_      = ioc_ + config.cancel_ / total;
+        }
+
+        // Passive order for building the initial book: bids strictly below the mid, asks above.
+        auto Seed(book::Command& command) -> void {
+            bool        buy    = (next_id_ & 1) == 0;
+            auto        offset = 1 + static_cast<book::Price>(std::fabs(price_(random_)) * config_.spread_);
+            book::Price price  = buy ? config_.mid_ - std::min(offset, config_.mid_ - 1) : config_.mid_ + offset;
+            MakeAdd(command, buy, price, false);
+        }
+
+        template <typename IsLive>
+        auto Next(book::Command& command, IsLive&& is_live) -> void {
+            double pick = uniform_(random_);
+            if (pick >= ioc_ && PickLive(is_live)) {
+                Live& target = live_[target_];
+                command      = book::Command{};
+                if (pick < cancel_) {
+                    command.msg_type_ = 'X';
+                    command.order_id_ = target.id_;
+                    live_[target_]    = live_.back();
+                    live_.pop_back();
+                } else {
+                    command.msg_type_ = 'M';
+                    command.order_id_ = target.id_;
+                    command.is_buy_   = target.buy_;
+                    command.price_    = LimitPrice(target.buy_);
+                    command.quantity_ = Quantity();
+                }
+                return;
+            }
+
+            bool buy = uniform_(random_) < 0.5;
+            if (pick >= add_ && pick < ioc_) {
+                auto offset = static_cast<book::Price>(std::fabs(price_(random_)) * config_.spread_);
+                MakeAdd(command, buy, buy ? config_.mid_ + offset : config_.mid_ - std::min(offset, config_.mid_ - 1),
+                        true);
+            } else {
+                MakeAdd(command, buy, LimitPrice(buy), false);
+            }
+        }
+
+    private:
+        struct Live {
+            book::OrderId id_;
+            bool          buy_;
+        };
+
+        auto MakeAdd(book::Command& command, bool buy, book::Price price, bool ioc) -> void {
+            command           = book::Command{};
+            command.msg_type_ = 'A';
+            command.order_id_ = next_id_++;
+            command.is_buy_   = buy;
+            command.ioc_      = ioc;
+            command.price_    = price;
+            command.quantity_ = Quantity();
+            if (!ioc) {
+                live_.push_back(Live{command.order_id_, buy});
+            }
+        }
+
+        auto LimitPrice(bool buy) -> book::Price {
+            auto offset = static_cast<int64_t>(std::lround(price_(random_) * config_.spread_));
+            auto price  = static_cast<int64_t>(config_.mid_) + (buy ? -offset : offset);
+            return static_cast<book::Price>(std::max<int64_t>(price, 1));
+        }
+
+        auto Quantity() -> book::Quantity {
+            return 1 + random_() % 100;
+        }
+
+        template <typename IsLive>
+        auto PickLive(IsLive&& is_live) -> bool {
+            while (!live_.empty()) {
+                target_ = random_() % live_.size();
+                if (is_live(live_[target_].id_)) {
+                    return true;
+                }
+                live_[target_] = live_.back();
+                live_.pop_back();
+            }
+            return false;
+        }
+
+        FlowConfig                       config_;
+        std::mt19937_64                  random_;
+        std::uniform_real_distribution<> uniform_{0.0, 1.0};
+        std::normal_distribution<>       price_{0.0, 1.0};
+        double                           add_;
+        double                           ioc_;
+        double                           cancel_;
+        std::vector<Live>                live_{};
+        size_t                           target_{0};
+        book::OrderId                    next_id_{0};
+    };
+}    // namespace akuna::bench
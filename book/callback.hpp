@@ -1,13 +1,14 @@
 #pragma once
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "types.hpp"
 
 namespace akuna::book {
-    template <class OrderPtr>
-    class OrderBook;
-
     template <typename T>
     std::ostream& operator<<(typename std::enable_if<std::is_enum<T>::value, std::ostream>::type& stream, const T& e) {
         return stream << static_cast<typename std::underlying_type<T>::type>(e);
@@ -16,9 +17,14 @@ namespace akuna::book {
     template <typename OrderPtr>
     class Callback {
     public:
-        using TypedOrderBook = OrderBook<OrderPtr>;
-
-        enum class CbType : int16_t { CB_UNKNOWN, CB_ORDER_ACCEPT, CB_ORDER_FILL, CB_ORDER_CANCEL, CB_ORDER_REPLACE };
+        enum class CbType : int16_t {
+            CB_UNKNOWN,
+            CB_ORDER_ACCEPT,
+            CB_ORDER_FILL,
+            CB_ORDER_CANCEL,
+            CB_ORDER_REPLACE,
+            CB_LEVEL_CANCEL
+        };
 
         static auto Accept(const OrderPtr& order) -> Callback<OrderPtr> {
             Callback<OrderPtr> result;
@@ -46,22 +52,110 @@ namespace akuna::book {
             return result;
         }
 
-        static auto Replace(const OrderPtr& passivated_order, const Quantity& open_qty, const OrderPtr& new_order)
+        static auto CancelLevel(const OrderPtr& first, const AggregateQuantity& open_qty, uint32_t orders)
                 -> Callback<OrderPtr> {
             Callback<OrderPtr> result;
+            result.type_           = CbType::CB_LEVEL_CANCEL;
+            result.order_          = first;
+            result.level_quantity_ = open_qty;
+            result.orders_         = orders;
+            return result;
+        }
+
+        static auto Replace(const OrderPtr& order, const Quantity& open_qty, const Delta& delta,
+                            const Price& new_price) -> Callback<OrderPtr> {
+            Callback<OrderPtr> result;
             result.type_     = CbType::CB_ORDER_REPLACE;
-            result.order_    = passivated_order;
+            result.order_    = order;
             result.quantity_ = open_qty;
-            result.delta_    = new_order->GetQuantity() - passivated_order->GetQuantity();
-            result.price_    = new_order->GetPrice();
+            result.delta_    = delta;
+            result.price_    = new_price;
             return result;
         }
 
-        CbType   type_{CbType::CB_UNKNOWN};
-        OrderPtr order_{nullptr};
-        OrderPtr matched_order_{nullptr};
-        Quantity quantity_{0};
-        Price    price_{0};
-        Delta    delta_{0};
+        CbType            type_{CbType::CB_UNKNOWN};
+        OrderPtr          order_{nullptr};
+        OrderPtr          matched_order_{nullptr};
+        Quantity          quantity_{0};
+        Price             price_{0};
+        Delta             delta_{0};
+        uint32_t          orders_{0};
+        AggregateQuantity level_quantity_{0};
+    };
+
+    // Listener policy that queues events as Callbacks and hands them to Inner only when the book
+    // finishes the operation, for consumers that want to see each Add, Cancel or Replace as one batch.
+    // By then every order is in its final state, replaced ones included.
+    template <typename OrderPtr, typename Inner>
+    class DeferredListener {
+    public:
+        using TypedCallback = Callback<OrderPtr>;
+        using Callbacks     = std::vector<TypedCallback>;
+
+        explicit DeferredListener(Inner inner = Inner{}) : inner_{std::move(inner)} {
+            callbacks_.reserve(8);
+        }
+
+        auto OnAccept(const OrderPtr& order) -> void {
+            callbacks_.push_back(TypedCallback::Accept(order));
+        }
+
+        auto OnFill(const OrderPtr& order, const OrderPtr& matched_order, Quantity fill_qty, Price fill_price) -> void {
+            callbacks_.push_back(TypedCallback::Fill(order, matched_order, fill_qty, fill_price));
+        }
+
+        auto OnCancel(const OrderPtr& order, Quantity open_qty) -> void {
+            callbacks_.push_back(TypedCallback::Cancel(order, open_qty));
+        }
+
+        auto OnCancelLevel(const OrderPtr& first, AggregateQuantity open_qty, uint32_t orders) -> void {
+            callbacks_.push_back(TypedCallback::CancelLevel(first, open_qty, orders));
+        }
+
+        auto OnReplace(const OrderPtr& order, Quantity open_qty, Delta delta, Price new_price) -> void {
+            callbacks_.push_back(TypedCallback::Replace(order, open_qty, delta, new_price));
+        }
+
+        template <typename Book>
+        auto OnComplete(const Book& book) -> void {
+            for (auto& cb : callbacks_) {
+                PerformCallback(cb);
+            }
+            callbacks_.clear();
+            inner_.OnComplete(book);
+        }
+
+        auto GetInner() -> Inner& {
+            return inner_;
+        }
+
+    private:
+        auto PerformCallback(TypedCallback& cb) -> void {
+            switch (cb.type_) {
+                case TypedCallback::CbType::CB_ORDER_FILL:
+                    inner_.OnFill(cb.order_, cb.matched_order_, cb.quantity_, cb.price_);
+                    break;
+                case TypedCallback::CbType::CB_ORDER_ACCEPT:
+                    inner_.OnAccept(cb.order_);
+                    break;
+                case TypedCallback::CbType::CB_ORDER_CANCEL:
+                    inner_.OnCancel(cb.order_, cb.quantity_);
+                    break;
+                case TypedCallback::CbType::CB_LEVEL_CANCEL:
+                    inner_.OnCancelLevel(cb.order_, cb.level_quantity_, cb.orders_);
+                    break;
+                case TypedCallback::CbType::CB_ORDER_REPLACE:
+                    inner_.OnReplace(cb.order_, cb.quantity_, cb.delta_, cb.price_);
+                    break;
+                default: {
+                    std::stringstream msg;
+                    msg << "Unexpected callback type " << cb.type_;
+                    throw std::runtime_error(msg.str());
+                }
+            }
+        }
+
+        Inner     inner_;
+        Callbacks callbacks_{};
     };
-}    // namespace akuna::book
\ No newline at end of file
+}    // namespace akuna::book
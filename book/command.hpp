@@ -0,0 +1,62 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // A decoded input message. msg_type_ is 'A' (add), 'M' (modify), 'X' (cancel), 'P' (print), 'S'
+    // (dump instrumentation, see stats.hpp), 'T' (advance the clock to timestamp_), 'E' (end of day)
+    // or 'C' (mass cancel); order_id_ is already interned, so nothing past the reader deals with id
+    // strings. name_ is the interned spelling of the id for adds and modifies, kept only for output.
+    // A non-zero stop_price_ makes an add a stop order, with price_ 0 for a stop-market one, a
+    // non-zero timestamp_ makes it good till that time, and group_ tags it with its owner or session.
+    // A mass cancel takes every order of group_ when it is set, and otherwise the is_buy_ side of
+    // symbol_ from price_ to high_price_.
+    struct Command {
+        bool             valid_{true};
+        char             msg_type_{'\0'};
+        OrderId          order_id_{INVALID_ORDER_ID};
+        bool             is_buy_{false};
+        bool             ioc_{false};
+        bool             all_or_none_{false};
+        Quantity         quantity_{0};
+        Price            price_{0};
+        Price            stop_price_{0};
+        Timestamp        timestamp_{0};
+        Price            high_price_{0};
+        Group            group_{0};
+        Symbol           symbol_{DEFAULT_SYMBOL};
+        std::string_view name_{};
+
+        friend std::ostream& operator<<(std::ostream& os, const Command& command) {
+            switch (command.msg_type_) {
+                case 'A':
+                    os << "msg_type : " << command.msg_type_ << " order_id : " << command.order_id_
+                       << " is_buy : " << command.is_buy_ << " ioc : " << command.ioc_
+                       << " all_or_none : " << command.all_or_none_ << " quantity : " << command.quantity_
+                       << " price : " << command.price_ << " stop_price : " << command.stop_price_
+                       << " timestamp : " << command.timestamp_ << " group : " << command.group_;
+                    break;
+                case 'M':
+                    os << "msg_type : " << command.msg_type_ << " order_id : " << command.order_id_
+                       << " is_buy : " << command.is_buy_ << " quantity : " << command.quantity_
+                       << " price : " << command.price_;
+                    break;
+                case 'X':
+                    os << "msg_type : " << command.msg_type_ << " order_id : " << command.order_id_;
+                    break;
+                case 'T':
+                    os << "msg_type : " << command.msg_type_ << " timestamp : " << command.timestamp_;
+                    break;
+                case 'C':
+                    os << "msg_type : " << command.msg_type_ << " group : " << command.group_
+                       << " is_buy : " << command.is_buy_ << " price : " << command.price_
+                       << " high_price : " << command.high_price_;
+                    break;
+            }
+            return os;
+        }
+    };
+}    // namespace akuna::book
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Aggregate view of one price level: the open quantity resting there and how many orders make it up.
+    struct DepthLevel {
+        Price             price_{0};
+        AggregateQuantity quantity_{0};
+        uint32_t          orders_{0};
+    };
+
+    // What taking quantity off one side in price order costs: cost_ sums price times quantity over
+    // the levels reached and worst_price_ is the last of them. quantity_ falls short of what was asked
+    // for when the side does not hold enough within the limit.
+    struct SweepCost {
+        AggregateQuantity quantity_{0};
+        Cost              cost_{0};
+        Price             worst_price_{0};
+
+        [[nodiscard]] auto Vwap() const -> double {
+            return quantity_ == 0 ? 0.0 : static_cast<double>(cost_) / static_cast<double>(quantity_);
+        }
+    };
+}    // namespace akuna::book
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <thread>
+#include <utility>
+
+#include "depth_level.hpp"
+#include "spsc_ring.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // Top of one book as of the end of an operation: up to DEPTH levels a side, best first, and the
+    // last trade price. version_ counts publications, so a reader can tell whether anything changed.
+    struct DepthSnapshot {
+        static constexpr size_t DEPTH{8};
+
+        uint64_t   version_{0};
+        Price      last_price_{MARKET_ORDER_PRICE};
+        uint32_t   bid_count_{0};
+        uint32_t   ask_count_{0};
+        DepthLevel bids_[DEPTH]{};
+        DepthLevel asks_[DEPTH]{};
+    };
+
+    // Hands the latest DepthSnapshot of a book from the matching thread to any number of reader
+    // threads through a seqlock: the writer makes the sequence odd, stores the snapshot word by
+    // word, then makes it even again. A reader that sees the same even sequence before and after
+    // copying has a consistent snapshot; otherwise it copies again. The writer never waits, and
+    // readers never write to shared memory, so they cannot slow it down beyond sharing its lines.
+    class alignas(CACHE_LINE_SIZE) DepthView {
+    public:
+        // Stamps snapshot with the next version and publishes it. Matching thread only.
+        auto Publish(DepthSnapshot& snapshot) -> void {
+            snapshot.version_ = ++version_;
+            uint64_t words[WORDS];
+            std::memcpy(words, &snapshot, sizeof(words));
+
+            uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WORDS; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Copies out the latest snapshot, or returns false if it was being replaced meanwhile.
+        [[nodiscard]] auto TryRead(DepthSnapshot& snapshot) const -> bool {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1) != 0) {
+                return false;
+            }
+            uint64_t words[WORDS];
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) != before) {
+                return false;
+            }
+            std::memcpy(&snapshot, words, sizeof(words));
+            return true;
+        }
+
+        // Copies out the latest snapshot, retrying until it gets a consistent one.
+        auto Read(DepthSnapshot& snapshot) const -> void {
+            while (!TryRead(snapshot)) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        static constexpr size_t WORDS{sizeof(DepthSnapshot) / sizeof(uint64_t)};
+
+        static_assert(sizeof(DepthSnapshot) % sizeof(uint64_t) == 0);
+
+        std::atomic<uint64_t>                    sequence_{0};
+        std::array<std::atomic<uint64_t>, WORDS> words_{};
+        uint64_t                                 version_{0};
+    };
+
+    // Listener policy that hands every event on to Inner and, when a DepthView is attached,
+    // publishes the top of the book into it once each operation completes.
+    template <typename Inner>
+    class DepthListener {
+    public:
+        explicit DepthListener(Inner inner = Inner{}, DepthView* view = nullptr)
+            : inner_{std::move(inner)}, view_{view} {
+        }
+
+        template <typename OrderPtr>
+        auto OnAccept(const OrderPtr& order) -> void {
+            inner_.OnAccept(order);
+        }
+
+        template <typename OrderPtr>
+        auto OnFill(const OrderPtr& order, const OrderPtr& matched_order, Quantity fill_qty, Price fill_price)
+                -> void {
+            inner_.OnFill(order, matched_order, fill_qty, fill_price);
+        }
+
+        template <typename OrderPtr>
+        auto OnCancel(const OrderPtr& order, Quantity open_qty) -> void {
+            inner_.OnCancel(order, open_qty);
+        }
+
+        template <typename OrderPtr>
+        auto OnCancelLevel(const OrderPtr& first, AggregateQuantity open_qty, uint32_t orders) -> void {
+            inner_.OnCancelLevel(first, open_qty, orders);
+        }
+
+        template <typename OrderPtr>
+        auto OnReplace(const OrderPtr& order, Quantity open_qty, Delta delta, Price new_price) -> void {
+            inner_.OnReplace(order, open_qty, delta, new_price);
+        }
+
+        template <typename Book>
+        auto OnComplete(const Book& book) -> void {
+            Publish(book);
+            inner_.OnComplete(book);
+        }
+
+        // Publishes the current top of book, e.g. right after attaching to a book that is not empty.
+        template <typename Book>
+        auto Publish(const Book& book) -> void {
+            if (view_) {
+                DepthSnapshot snapshot;
+                snapshot.last_price_ = book.GetMarketPrice();
+                snapshot.bid_count_  = static_cast<uint32_t>(book.GetBids().Top(snapshot.bids_));
+                snapshot.ask_count_  = static_cast<uint32_t>(book.GetAsks().Top(snapshot.asks_));
+                view_->Publish(snapshot);
+            }
+        }
+
+        auto GetInner() -> Inner& {
+            return inner_;
+        }
+
+    private:
+        Inner      inner_;
+        DepthView* view_;
+    };
+}    // namespace akuna::book
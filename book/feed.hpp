@@ -0,0 +1,261 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include "spsc_ring.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // One incremental market-data message, all fields little-endian. Order messages follow the book
+    // event by event; LEVEL messages close each operation with the aggregate of every price level it
+    // touched, so a consumer can keep either an order-by-order or a depth view from the same stream.
+    //   ADD      order_id_ entered on side_ at price_ for quantity_
+    //   EXECUTE  order_id_ (resting, on side_ at price_) traded quantity_ with other_id_
+    //   CANCEL   order_id_ left the book with quantity_ still open
+    //   CLEAR    every order on side_ at price_ was cancelled at once, orders_ of them with quantity_
+    //            open between them; the level is gone and no LEVEL follows for it
+    //   REPLACE  order_id_ now rests at price_ for quantity_, losing its time priority
+    //   LEVEL    side_ at price_ now holds quantity_ over orders_ orders; 0 removes the level
+    struct FeedMessage {
+        static constexpr char ADD{'A'};
+        static constexpr char EXECUTE{'E'};
+        static constexpr char CANCEL{'X'};
+        static constexpr char CLEAR{'C'};
+        static constexpr char REPLACE{'U'};
+        static constexpr char LEVEL{'L'};
+        static constexpr char BUY{'B'};
+        static constexpr char SELL{'S'};
+
+        uint64_t sequence_{0};
+        char     msg_type_{'\0'};
+        char     side_{'\0'};
+        uint16_t reserved_{0};
+        OrderId  order_id_{INVALID_ORDER_ID};
+        OrderId  other_id_{INVALID_ORDER_ID};
+        uint32_t orders_{0};
+        uint64_t symbol_{0};
+        uint64_t price_{0};
+        uint64_t quantity_{0};
+    };
+
+    static_assert(sizeof(FeedMessage) == 48);
+
+    // Layout of the shared-memory segment: a FeedHeader on its own cache line, then capacity_ slots
+    // of one cache line each. Message n goes to slot n % capacity_ and is guarded by the slot's
+    // sequence word in the manner of a seqlock: the writer zeroes it, stores the payload, then stores
+    // n. A reader that sees n before and after copying the payload has a consistent message.
+    struct FeedHeader {
+        char     magic_[4]{'A', 'K', 'F', 'D'};
+        uint32_t version_{1};
+        uint64_t capacity_{0};
+        uint64_t head_{0};      // last published sequence
+        uint64_t closed_{0};    // set once the writer is done
+    };
+
+    struct alignas(CACHE_LINE_SIZE) FeedSlot {
+        static constexpr size_t WORDS{sizeof(FeedMessage) / sizeof(uint64_t)};
+
+        uint64_t sequence_{0};
+        uint64_t payload_[WORDS]{};
+    };
+
+    static_assert(sizeof(FeedHeader) <= CACHE_LINE_SIZE);
+    static_assert(sizeof(FeedSlot) == CACHE_LINE_SIZE);
+
+    // Publishes messages into a named shared-memory segment for any number of readers. The writer
+    // never waits for them: a reader that falls more than capacity_ messages behind is lapped and
+    // finds out on its next Poll. Capacity is rounded up to a power of two.
+    class FeedWriter {
+    public:
+        FeedWriter(const std::string& name, size_t capacity) : name_{SegmentName(name)} {
+            capacity_ = 2;
+            while (capacity_ < capacity) {
+                capacity_ <<= 1;
+            }
+            size_ = CACHE_LINE_SIZE + capacity_ * sizeof(FeedSlot);
+
+            // A segment left behind by an earlier run may still be mapped by its readers; they keep
+            // the old one and new readers get a fresh one.
+            ::shm_unlink(name_.c_str());
+            int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0) {
+                return;
+            }
+            if (::ftruncate(fd, static_cast<off_t>(size_)) == 0) {
+                void* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (data != MAP_FAILED) {
+                    data_ = static_cast<char*>(data);
+                }
+            }
+            ::close(fd);
+            if (data_ == nullptr) {
+                ::shm_unlink(name_.c_str());
+                return;
+            }
+            header_ = new (data_) FeedHeader{};
+            header_->capacity_ = capacity_;
+            slots_ = reinterpret_cast<FeedSlot*>(data_ + CACHE_LINE_SIZE);
+        }
+
+        FeedWriter(const FeedWriter&) = delete;
+        auto operator=(const FeedWriter&) -> FeedWriter& = delete;
+
+        // Marks the feed closed so readers can stop once they have caught up. The segment is left in
+        // place for readers that attach late.
+        ~FeedWriter() {
+            if (data_ != nullptr) {
+                __atomic_store_n(&header_->closed_, 1, __ATOMIC_RELEASE);
+                ::munmap(data_, size_);
+            }
+        }
+
+        [[nodiscard]] auto IsOpen() const -> bool {
+            return data_ != nullptr;
+        }
+
+        // Stamps message with the next sequence number and publishes it.
+        auto Publish(FeedMessage& message) -> void {
+            message.sequence_ = ++sequence_;
+            FeedSlot& slot    = slots_[sequence_ & (capacity_ - 1)];
+            uint64_t  words[FeedSlot::WORDS];
+            std::memcpy(words, &message, sizeof(words));
+
+            __atomic_store_n(&slot.sequence_, 0, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+            for (size_t i = 0; i < FeedSlot::WORDS; ++i) {
+                __atomic_store_n(&slot.payload_[i], words[i], __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&slot.sequence_, sequence_, __ATOMIC_RELEASE);
+            __atomic_store_n(&header_->head_, sequence_, __ATOMIC_RELEASE);
+        }
+
+        [[nodiscard]] auto Sequence() const -> uint64_t {
+            return sequence_;
+        }
+
+        static auto SegmentName(const std::string& name) -> std::string {
+            return name.starts_with('/') ? name : '/' + name;
+        }
+
+    private:
+        std::string name_;
+        size_t      capacity_{0};
+        size_t      size_{0};
+        char*       data_{nullptr};
+        FeedHeader* header_{nullptr};
+        FeedSlot*   slots_{nullptr};
+        uint64_t    sequence_{0};
+    };
+
+    // Follows a feed published by FeedWriter, one message at a time, starting from the oldest one
+    // still held when it attaches. The mapping is read-only, so readers cannot disturb the writer or
+    // each other.
+    class FeedReader {
+    public:
+        enum class Status { OK, EMPTY, LAPPED };
+
+        explicit FeedReader(const std::string& name) {
+            int fd = ::shm_open(FeedWriter::SegmentName(name).c_str(), O_RDONLY, 0);
+            if (fd < 0) {
+                return;
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) > CACHE_LINE_SIZE) {
+                size_      = static_cast<size_t>(info.st_size);
+                void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+                if (data != MAP_FAILED) {
+                    data_ = static_cast<const char*>(data);
+                }
+            }
+            ::close(fd);
+            header_ = reinterpret_cast<const FeedHeader*>(data_);
+            if (data_ == nullptr || std::memcmp(header_->magic_, FeedHeader{}.magic_, 4) != 0 ||
+                header_->version_ != 1 || CACHE_LINE_SIZE + header_->capacity_ * sizeof(FeedSlot) > size_) {
+                Close();
+                return;
+            }
+            capacity_ = header_->capacity_;
+            slots_    = reinterpret_cast<const FeedSlot*>(data_ + CACHE_LINE_SIZE);
+            Resync();
+        }
+
+        FeedReader(const FeedReader&) = delete;
+        auto operator=(const FeedReader&) -> FeedReader& = delete;
+
+        ~FeedReader() {
+            Close();
+        }
+
+        [[nodiscard]] auto IsOpen() const -> bool {
+            return data_ != nullptr;
+        }
+
+        // Copies out the next message. EMPTY means nothing new has been published yet. LAPPED means
+        // the writer has overwritten messages this reader had not read; nothing is returned and the
+        // reader stays where it was until Resync.
+        [[nodiscard]] auto Poll(FeedMessage& message) -> Status {
+            const FeedSlot& slot     = slots_[next_ & (capacity_ - 1)];
+            uint64_t        sequence = __atomic_load_n(&slot.sequence_, __ATOMIC_ACQUIRE);
+            if (sequence != next_) {
+                if (sequence > next_ || (sequence == 0 && Head() >= next_)) {
+                    return Status::LAPPED;
+                }
+                return Status::EMPTY;
+            }
+            uint64_t words[FeedSlot::WORDS];
+            for (size_t i = 0; i < FeedSlot::WORDS; ++i) {
+                words[i] = __atomic_load_n(&slot.payload_[i], __ATOMIC_RELAXED);
+            }
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot.sequence_, __ATOMIC_RELAXED) != next_) {
+                return Status::LAPPED;
+            }
+            std::memcpy(&message, words, sizeof(words));
+            ++next_;
+            return Status::OK;
+        }
+
+        // Skips to the oldest message the ring still holds.
+        auto Resync() -> void {
+            uint64_t head = Head();
+            next_         = head >= capacity_ ? head - capacity_ + 2 : 1;
+        }
+
+        // True once the writer has finished; messages may still be waiting to be polled.
+        [[nodiscard]] auto Closed() const -> bool {
+            return __atomic_load_n(&header_->closed_, __ATOMIC_ACQUIRE) != 0;
+        }
+
+        // Sequence of the message the next successful Poll returns.
+        [[nodiscard]] auto NextSequence() const -> uint64_t {
+            return next_;
+        }
+
+        [[nodiscard]] auto Head() const -> uint64_t {
+            return __atomic_load_n(&header_->head_, __ATOMIC_ACQUIRE);
+        }
+
+    private:
+        auto Close() -> void {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<char*>(data_), size_);
+                data_ = nullptr;
+            }
+        }
+
+        size_t            size_{0};
+        size_t            capacity_{0};
+        const char*       data_{nullptr};
+        const FeedHeader* header_{nullptr};
+        const FeedSlot*   slots_{nullptr};
+        uint64_t          next_{1};
+    };
+}    // namespace akuna::book
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "depth_level.hpp"
+#include "feed.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // Listener policy that hands every event on to Inner and, when a FeedWriter is attached, also
+    // publishes it as incremental market data. A replace arrives from the book as the accept of the
+    // new order followed by the replace of the old one, and goes out as a single REPLACE. Once the
+    // operation completes, every price level it touched is published as a LEVEL message read back
+    // from the book, including levels it emptied. A level cancelled as a whole goes out as a single
+    // CLEAR instead.
+    template <typename Inner>
+    class FeedListener {
+    public:
+        explicit FeedListener(Inner inner = Inner{}, FeedWriter* feed = nullptr)
+            : inner_{std::move(inner)}, feed_{feed} {
+        }
+
+        template <typename OrderPtr>
+        auto OnAccept(const OrderPtr& order) -> void {
+            inner_.OnAccept(order);
+            if (feed_) {
+                FlushPending();
+                pending_           = Message(FeedMessage::ADD, order, order->GetPrice());
+                pending_.quantity_ = order->GetQuantity();
+                has_pending_       = true;
+            }
+        }
+
+        template <typename OrderPtr>
+        auto OnFill(const OrderPtr& order, const OrderPtr& matched_order, Quantity fill_qty, Price fill_price)
+                -> void {
+            inner_.OnFill(order, matched_order, fill_qty, fill_price);
+            if (feed_) {
+                FlushPending();
+                FeedMessage message = Message(FeedMessage::EXECUTE, matched_order, matched_order->GetPrice());
+                message.other_id_   = order->GetOrderId();
+                message.quantity_   = fill_qty;
+                feed_->Publish(message);
+            }
+        }
+
+        template <typename OrderPtr>
+        auto OnCancel(const OrderPtr& order, Quantity open_qty) -> void {
+            inner_.OnCancel(order, open_qty);
+            if (feed_) {
+                FlushPending();
+                FeedMessage message = Message(FeedMessage::CANCEL, order, order->GetPrice());
+                message.quantity_   = open_qty;
+                feed_->Publish(message);
+            }
+        }
+
+        template <typename OrderPtr>
+        auto OnCancelLevel(const OrderPtr& first, AggregateQuantity open_qty, uint32_t orders) -> void {
+            inner_.OnCancelLevel(first, open_qty, orders);
+            if (feed_) {
+                FlushPending();
+                FeedMessage message;
+                message.msg_type_ = FeedMessage::CLEAR;
+                message.side_     = first->IsBuy() ? FeedMessage::BUY : FeedMessage::SELL;
+                message.symbol_   = first->GetSymbol();
+                message.price_    = first->GetPrice();
+                message.quantity_ = open_qty;
+                message.orders_   = orders;
+                feed_->Publish(message);
+            }
+        }
+
+        // Called while order still has its old price, which is the level it leaves.
+        template <typename OrderPtr>
+        auto OnReplace(const OrderPtr& order, Quantity open_qty, Delta delta, Price new_price) -> void {
+            inner_.OnReplace(order, open_qty, delta, new_price);
+            if (feed_) {
+                Touch(order->IsBuy(), order->GetSymbol(), order->GetPrice());
+                if (has_pending_ && pending_.order_id_ == order->GetOrderId()) {
+                    pending_.msg_type_ = FeedMessage::REPLACE;
+                }
+                FlushPending();
+            }
+        }
+
+        template <typename Book>
+        auto OnComplete(const Book& book) -> void {
+            if (feed_) {
+                FlushPending();
+                for (const Touched& touched : touched_) {
+                    DepthLevel level{};
+                    bool       found = touched.buy_side_ ? book.GetBids().LevelAt(touched.price_, level)
+                                                         : book.GetAsks().LevelAt(touched.price_, level);
+                    if (!found) {
+                        level = DepthLevel{touched.price_, 0, 0};
+                    }
+                    FeedMessage message;
+                    message.msg_type_ = FeedMessage::LEVEL;
+                    message.side_     = touched.buy_side_ ? FeedMessage::BUY : FeedMessage::SELL;
+                    message.symbol_   = touched.symbol_;
+                    message.price_    = touched.price_;
+                    message.quantity_ = level.quantity_;
+                    message.orders_   = level.orders_;
+                    feed_->Publish(message);
+                }
+                touched_.clear();
+            }
+            inner_.OnComplete(book);
+        }
+
+        auto GetInner() -> Inner& {
+            return inner_;
+        }
+
+    private:
+        struct Touched {
+            bool   buy_side_;
+            Symbol symbol_;
+            Price  price_;
+        };
+
+        template <typename OrderPtr>
+        auto Message(char msg_type, const OrderPtr& order, Price price) -> FeedMessage {
+            Touch(order->IsBuy(), order->GetSymbol(), price);
+            FeedMessage message;
+            message.msg_type_ = msg_type;
+            message.side_     = order->IsBuy() ? FeedMessage::BUY : FeedMessage::SELL;
+            message.order_id_ = order->GetOrderId();
+            message.symbol_   = order->GetSymbol();
+            message.price_    = price;
+            return message;
+        }
+
+        // Searches from the latest entry, since operations that touch many levels, such as purges,
+        // go through them one at a time.
+        auto Touch(bool buy_side, Symbol symbol, Price price) -> void {
+            for (auto touched = touched_.rbegin(); touched != touched_.rend(); ++touched) {
+                if (touched->price_ == price && touched->buy_side_ == buy_side && touched->symbol_ == symbol) {
+                    return;
+                }
+            }
+            touched_.push_back(Touched{buy_side, symbol, price});
+        }
+
+        auto FlushPending() -> void {
+            if (has_pending_) {
+                feed_->Publish(pending_);
+                has_pending_ = false;
+            }
+        }
+
+        Inner                inner_;
+        FeedWriter*          feed_;
+        FeedMessage          pending_{};
+        bool                 has_pending_{false};
+        std::vector<Touched> touched_{};
+    };
+}    // namespace akuna::book
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // One execution between a resting order (maker) and an inbound one (taker). price_ is the
+    // maker's price, the level the quantity traded at.
+    struct Fill {
+        FillId   fill_id_{0};
+        OrderId  maker_{INVALID_ORDER_ID};
+        OrderId  taker_{INVALID_ORDER_ID};
+        Quantity quantity_{0};
+        Price    price_{0};
+    };
+}    // namespace akuna::book
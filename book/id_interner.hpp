@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Maps external order id strings to dense integer OrderIds. Interning happens once at the gateway;
+    // everything past it works on the integer id. Names are copied into a chunked arena so views
+    // handed out by Name stay valid for the lifetime of the interner.
+    class IdInterner {
+    public:
+        explicit IdInterner(size_t capacity = 1024) {
+            size_t slots = 16;
+            while (slots < capacity * 2) {
+                slots <<= 1;
+            }
+            slots_.resize(slots);
+            names_.reserve(capacity);
+        }
+
+        auto Intern(std::string_view name) -> OrderId {
+            size_t hash = Hash(name);
+            size_t pos  = Probe(name, hash);
+            if (slots_[pos].id_ != INVALID_ORDER_ID) {
+                return slots_[pos].id_;
+            }
+
+            auto id = static_cast<OrderId>(names_.size());
+            names_.push_back(Store(name));
+            slots_[pos] = Slot{hash, id};
+            if (names_.size() * 2 > slots_.size()) {
+                Grow();
+            }
+            return id;
+        }
+
+        [[nodiscard]] auto Find(std::string_view name) const -> OrderId {
+            return slots_[Probe(name, Hash(name))].id_;
+        }
+
+        [[nodiscard]] auto Name(OrderId id) const -> std::string_view {
+            return names_[id];
+        }
+
+        [[nodiscard]] auto Size() const -> size_t {
+            return names_.size();
+        }
+
+    private:
+        static constexpr size_t CHUNK_SIZE{64 * 1024};
+
+        struct Slot {
+            size_t  hash_{0};
+            OrderId id_{INVALID_ORDER_ID};
+        };
+
+        [[nodiscard]] static auto Hash(std::string_view name) -> size_t {
+            return std::hash<std::string_view>{}(name);
+        }
+
+        [[nodiscard]] auto Probe(std::string_view name, size_t hash) const -> size_t {
+            size_t mask = slots_.size() - 1;
+            size_t pos  = hash & mask;
+            while (slots_[pos].id_ != INVALID_ORDER_ID &&
+                   (slots_[pos].hash_ != hash || names_[slots_[pos].id_] != name)) {
+                pos = (pos + 1) & mask;
+            }
+            return pos;
+        }
+
+        auto Grow() -> void {
+            std::vector<Slot> slots(slots_.size() * 2);
+            size_t            mask = slots.size() - 1;
+            for (const auto& slot : slots_) {
+                if (slot.id_ != INVALID_ORDER_ID) {
+                    size_t pos = slot.hash_ & mask;
+                    while (slots[pos].id_ != INVALID_ORDER_ID) {
+                        pos = (pos + 1) & mask;
+                    }
+                    slots[pos] = slot;
+                }
+            }
+            slots_.swap(slots);
+        }
+
+        auto Store(std::string_view name) -> std::string_view {
+            if (name.size() > remaining_) {
+                size_t size = std::max(CHUNK_SIZE, name.size());
+                chunks_.push_back(std::make_unique<char[]>(size));
+                cursor_    = chunks_.back().get();
+                remaining_ = size;
+            }
+            std::memcpy(cursor_, name.data(), name.size());
+            std::string_view stored{cursor_, name.size()};
+            cursor_ += name.size();
+            remaining_ -= name.size();
+            return stored;
+        }
+
+        std::vector<Slot>                    slots_{};
+        std::vector<std::string_view>        names_{};
+        std::vector<std::unique_ptr<char[]>> chunks_{};
+        char*                                cursor_{nullptr};
+        size_t                               remaining_{0};
+    };
+}    // namespace akuna::book
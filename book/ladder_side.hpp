@@ -0,0 +1,369 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "depth_level.hpp"
+#include "level_index.hpp"
+#include "order_tracker.hpp"
+#include "side_traits.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // One side of the book kept as a sorted array of price levels, worst level first so that the best
+    // level sits at the back where inserts and removals are cheapest. Each level is a FIFO threaded
+    // through a shared node pool, so resting an order never allocates once the pool has warmed up.
+    // Every level carries its open quantity and order count, kept current as orders come and go, and
+    // a LevelIndex over the levels answers cumulative depth queries. Traits is one of the side traits
+    // in side_traits.hpp.
+    template <typename OrderPtr, typename Traits>
+    class LadderSide {
+    public:
+        using Tracker = OrderTracker<OrderPtr>;
+        using Handle  = uint32_t;
+
+        static constexpr Handle NIL{UINT32_MAX};
+
+        LadderSide() {
+            levels_.reserve(64);
+            nodes_.reserve(1024);
+        }
+
+        [[nodiscard]] auto Empty() const -> bool {
+            return levels_.empty();
+        }
+
+        // limit comes from the other side's Limit.
+        [[nodiscard]] auto Matches(Price limit) const -> bool {
+            return levels_.back().rank_ >= Traits::Bound(limit);
+        }
+
+        [[nodiscard]] auto Front() -> Tracker& {
+            return nodes_[levels_.back().head_].tracker_;
+        }
+
+        // Accounts for qty traded off the front order, which the caller has already filled.
+        auto ReduceFront(Quantity qty) -> void {
+            levels_.back().quantity_ -= qty;
+            quantity_ -= qty;
+            index_.Invalidate(levels_.size() - 1);
+        }
+
+        auto PopFront() -> void {
+            Level& best = levels_.back();
+            Handle pos  = best.head_;
+            Unlink(best, nodes_[pos].tracker_);
+            best.head_ = nodes_[pos].next_;
+            if (best.head_ == NIL) {
+                levels_.pop_back();
+            } else {
+                nodes_[best.head_].prev_ = NIL;
+            }
+            Release(pos);
+        }
+
+        auto Insert(Price price, const Tracker& tracker) -> Handle {
+            const Key RANK  = Rank(price);
+            auto      level = LowerBound(RANK);
+            if (level == levels_.end() || level->rank_ != RANK) {
+                level = levels_.insert(level, Level{RANK, price, NIL, NIL, 0, 0});
+            }
+            level->quantity_ += tracker.OpenQty();
+            ++level->orders_;
+            quantity_ += tracker.OpenQty();
+            index_.Invalidate(static_cast<size_t>(level - levels_.begin()));
+
+            Handle pos        = Acquire(tracker);
+            nodes_[pos].prev_ = level->tail_;
+            if (level->tail_ == NIL) {
+                level->head_ = pos;
+            } else {
+                nodes_[level->tail_].next_ = pos;
+            }
+            level->tail_ = pos;
+            return pos;
+        }
+
+        [[nodiscard]] auto Find(const OrderPtr& order, Handle& result) -> bool {
+            const Key RANK  = Rank(Traits::PriceOf(order));
+            auto      level = LowerBound(RANK);
+            [[maybe_unused]] size_t scanned = 0;
+            if (level != levels_.end() && level->rank_ == RANK) {
+                for (result = level->head_; result != NIL; result = nodes_[result].next_) {
+                    ++scanned;
+                    if (nodes_[result].tracker_.Ptr() == order) {
+                        STATS_RECORD(FIND_SCAN, scanned);
+                        return true;
+                    }
+                }
+            }
+            STATS_RECORD(FIND_SCAN, scanned);
+            result = NIL;
+            return false;
+        }
+
+        // A handle stays valid until its order leaves the book; a stale one never resolves to a
+        // different order because the slot is cleared on release.
+        [[nodiscard]] auto Locate(const OrderPtr& order, Handle pos) const -> bool {
+            return pos < nodes_.size() && nodes_[pos].tracker_.Ptr() == order;
+        }
+
+        [[nodiscard]] auto At(Handle pos) -> Tracker& {
+            return nodes_[pos].tracker_;
+        }
+
+        auto Erase(Handle pos) -> void {
+            Node& node  = nodes_[pos];
+            auto  level = LowerBound(Rank(Traits::PriceOf(node.tracker_.Ptr())));
+            Unlink(*level, node.tracker_);
+            Detach(*level, node);
+            if (level->head_ == NIL) {
+                levels_.erase(level);
+            }
+            Release(pos);
+        }
+
+        template <typename Fn>
+        auto ForEach(Fn&& fn) const -> void {
+            for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+                for (Handle pos = level->head_; pos != NIL; pos = nodes_[pos].next_) {
+                    fn(level->price_, nodes_[pos].tracker_);
+                }
+            }
+        }
+
+        // Takes every level priced from low to high off the side in one pass, best first. For each
+        // level, on_order(tracker) is called for its orders in priority order, then on_level(level,
+        // first) with the level's totals and its first order.
+        template <typename OnOrder, typename OnLevel>
+        auto EraseLevels(Price low, Price high, OnOrder&& on_order, OnLevel&& on_level) -> void {
+            size_t count = levels_.size();
+            size_t kept  = count;
+            size_t first = count;
+            for (size_t i = count; i-- > 0;) {
+                const Level level = levels_[i];
+                if (level.price_ < low || level.price_ > high) {
+                    levels_[--kept] = level;
+                    continue;
+                }
+                OrderPtr front = nodes_[level.head_].tracker_.Ptr();
+                for (Handle pos = level.head_; pos != NIL;) {
+                    Handle next = nodes_[pos].next_;
+                    on_order(nodes_[pos].tracker_);
+                    Release(pos);
+                    pos = next;
+                }
+                quantity_ -= level.quantity_;
+                first = i;
+                on_level(DepthLevel{level.price_, level.quantity_, level.orders_}, front);
+            }
+            levels_.erase(levels_.begin(), levels_.begin() + static_cast<std::ptrdiff_t>(kept));
+            index_.Invalidate(first);
+        }
+
+        // Takes every order for which drop(tracker) holds off the side in one pass, best level first,
+        // calling on_order(tracker) for each. The orders that stay keep their nodes, so their handles
+        // stay valid, and emptied levels are closed up the way EraseLevels does.
+        template <typename Drop, typename OnOrder>
+        auto EraseIf(Drop&& drop, OnOrder&& on_order) -> void {
+            size_t count = levels_.size();
+            size_t kept  = count;
+            size_t first = count;
+            for (size_t i = count; i-- > 0;) {
+                Level level = levels_[i];
+                for (Handle pos = level.head_; pos != NIL;) {
+                    const Node& node = nodes_[pos];
+                    Handle      next = node.next_;
+                    if (drop(node.tracker_)) {
+                        on_order(node.tracker_);
+                        level.quantity_ -= node.tracker_.OpenQty();
+                        --level.orders_;
+                        quantity_ -= node.tracker_.OpenQty();
+                        Detach(level, node);
+                        Release(pos);
+                        first = i;
+                    }
+                    pos = next;
+                }
+                if (level.head_ != NIL) {
+                    levels_[--kept] = level;
+                }
+            }
+            levels_.erase(levels_.begin(), levels_.begin() + static_cast<std::ptrdiff_t>(kept));
+            index_.Invalidate(first);
+        }
+
+        [[nodiscard]] auto LevelCount() const -> size_t {
+            return levels_.size();
+        }
+
+        [[nodiscard]] auto OpenQuantity() const -> AggregateQuantity {
+            return quantity_;
+        }
+
+        [[nodiscard]] auto Best(DepthLevel& level) const -> bool {
+            return Top(std::span<DepthLevel>{&level, 1}) == 1;
+        }
+
+        [[nodiscard]] auto LevelAt(Price price, DepthLevel& level) const -> bool {
+            const Key RANK  = Rank(price);
+            auto      found = std::lower_bound(levels_.begin(), levels_.end(), RANK,
+                                               [](const Level& level, Key value) { return level.rank_ < value; });
+            if (found == levels_.end() || found->rank_ != RANK) {
+                return false;
+            }
+            level = DepthLevel{found->price_, found->quantity_, found->orders_};
+            return true;
+        }
+
+        // Open quantity an inbound order of the other side with the given limit could trade against,
+        // in O(log levels).
+        [[nodiscard]] auto QuantityWithin(Price limit) const -> AggregateQuantity {
+            size_t reachable = Reachable(limit);
+            index_.Refresh(levels_);
+            return index_.Prefix(levels_.size()).quantity_ - index_.Prefix(reachable).quantity_;
+        }
+
+        // Cost of taking quantity off this side, best price first, for an inbound order of the other
+        // side with the given limit, in O(log levels). Resting market orders count at price 0.
+        [[nodiscard]] auto Sweep(Price limit, Quantity quantity) const -> SweepCost {
+            size_t    count     = levels_.size();
+            size_t    reachable = Reachable(limit);
+            SweepCost sweep;
+            if (reachable == count || quantity == 0) {
+                return sweep;
+            }
+            index_.Refresh(levels_);
+            LevelIndex::Sums total   = index_.Prefix(count);
+            LevelIndex::Sums skipped = index_.Prefix(reachable);
+            if (total.quantity_ - skipped.quantity_ <= quantity) {
+                sweep.quantity_    = total.quantity_ - skipped.quantity_;
+                sweep.cost_        = total.notional_ - skipped.notional_;
+                sweep.worst_price_ = levels_[reachable].price_;
+                return sweep;
+            }
+            // The levels after last hold less than quantity and last makes up the rest.
+            size_t           last  = index_.Search(total.quantity_ - quantity, count);
+            LevelIndex::Sums worse = index_.Prefix(last + 1);
+            uint64_t         rest  = quantity - (total.quantity_ - worse.quantity_);
+            sweep.quantity_        = quantity;
+            sweep.cost_            = total.notional_ - worse.notional_ + rest * levels_[last].price_;
+            sweep.worst_price_     = levels_[last].price_;
+            return sweep;
+        }
+
+        // Fills out with up to out.size() levels, best first, and returns how many were written.
+        auto Top(std::span<DepthLevel> out) const -> size_t {
+            size_t count = std::min(out.size(), levels_.size());
+            auto   level = levels_.rbegin();
+            for (size_t i = 0; i < count; ++i, ++level) {
+                out[i] = DepthLevel{level->price_, level->quantity_, level->orders_};
+            }
+            return count;
+        }
+
+        // Visits every level, best first.
+        template <typename Fn>
+        auto ForEachLevel(Fn&& fn) const -> void {
+            for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+                fn(DepthLevel{level->price_, level->quantity_, level->orders_});
+            }
+        }
+
+        // Visits every level, worst first.
+        template <typename Fn>
+        auto ForEachLevelReverse(Fn&& fn) const -> void {
+            for (const auto& level : levels_) {
+                fn(DepthLevel{level.price_, level.quantity_, level.orders_});
+            }
+        }
+
+    private:
+        // Levels are ordered by rank, which grows towards the better price on either side.
+        using Key = Price;
+
+        struct Level {
+            Key               rank_;
+            Price             price_;
+            Handle            head_;
+            Handle            tail_;
+            AggregateQuantity quantity_;
+            uint32_t          orders_;
+        };
+
+        struct Node {
+            Tracker tracker_{};
+            Handle  prev_{NIL};
+            Handle  next_{NIL};
+        };
+
+        using Levels = std::vector<Level>;
+
+        [[nodiscard]] static auto Rank(Price price) -> Key {
+            return Traits::Rank(price);
+        }
+
+        // Position of the first level an inbound order of the other side with the given limit reaches;
+        // every level after it is better.
+        [[nodiscard]] auto Reachable(Price limit) const -> size_t {
+            auto level = std::lower_bound(levels_.begin(), levels_.end(), Traits::Bound(limit),
+                                          [](const Level& level, Key value) { return level.rank_ < value; });
+            return static_cast<size_t>(level - levels_.begin());
+        }
+
+        [[nodiscard]] auto LowerBound(Key rank) -> typename Levels::iterator {
+            return std::lower_bound(levels_.begin(), levels_.end(), rank,
+                                    [](const Level& level, Key value) { return level.rank_ < value; });
+        }
+
+        auto Unlink(Level& level, const Tracker& tracker) -> void {
+            level.quantity_ -= tracker.OpenQty();
+            --level.orders_;
+            quantity_ -= tracker.OpenQty();
+            index_.Invalidate(static_cast<size_t>(&level - levels_.data()));
+        }
+
+        // Takes node out of level's FIFO.
+        auto Detach(Level& level, const Node& node) -> void {
+            if (node.prev_ == NIL) {
+                level.head_ = node.next_;
+            } else {
+                nodes_[node.prev_].next_ = node.next_;
+            }
+            if (node.next_ == NIL) {
+                level.tail_ = node.prev_;
+            } else {
+                nodes_[node.next_].prev_ = node.prev_;
+            }
+        }
+
+        auto Acquire(const Tracker& tracker) -> Handle {
+            Handle pos;
+            if (free_ == NIL) {
+                pos = static_cast<Handle>(nodes_.size());
+                nodes_.push_back(Node{tracker});
+            } else {
+                pos         = free_;
+                free_       = nodes_[pos].next_;
+                nodes_[pos] = Node{tracker};
+            }
+            return pos;
+        }
+
+        auto Release(Handle pos) -> void {
+            nodes_[pos].tracker_ = Tracker{};
+            nodes_[pos].next_    = free_;
+            free_                = pos;
+        }
+
+        Levels            levels_{};
+        std::vector<Node> nodes_{};
+        Handle            free_{NIL};
+        AggregateQuantity quantity_{0};
+        // Refreshed by the const depth queries.
+        mutable LevelIndex index_{};
+    };
+}    // namespace akuna::book
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Fenwick tree of the open quantity and notional (price times quantity) of a side's price levels,
+    // indexed by level position, so the totals held by any run of levels at one end of the side cost
+    // O(log levels). Levels are inserted and removed in the middle of the array, which shifts every
+    // position after them, so the tree is not updated as the book changes: the side only reports the
+    // first position it touched, and the tree is brought up to date from there when it is next read.
+    // Matching works at the best end of the side, so a refresh usually recomputes a handful of nodes.
+    class LevelIndex {
+    public:
+        struct Sums {
+            AggregateQuantity quantity_{0};
+            Cost              notional_{0};
+        };
+
+        // Levels from position first on have changed.
+        auto Invalidate(size_t first) -> void {
+            stale_ = std::min(stale_, first);
+        }
+
+        // Recomputes the nodes covering positions from the first stale one on. levels is the side's
+        // level array; each element has a price_ and a quantity_.
+        template <typename Levels>
+        auto Refresh(const Levels& levels) -> void {
+            size_t count = levels.size();
+            if (stale_ >= count) {
+                stale_ = count;
+                return;
+            }
+            tree_.resize(count + 1);
+            for (size_t node = stale_ + 1; node <= count; ++node) {
+                const auto& level = levels[node - 1];
+                Sums        sums{level.quantity_, static_cast<Cost>(level.price_) * level.quantity_};
+                size_t      first = node - (node & -node);
+                for (size_t child = node - 1; child > first; child -= child & -child) {
+                    sums.quantity_ += tree_[child].quantity_;
+                    sums.notional_ += tree_[child].notional_;
+                }
+                tree_[node] = sums;
+            }
+            stale_ = count;
+        }
+
+        // Totals of the first count levels. Only valid straight after Refresh.
+        [[nodiscard]] auto Prefix(size_t count) const -> Sums {
+            Sums sums;
+            for (size_t node = count; node > 0; node -= node & -node) {
+                sums.quantity_ += tree_[node].quantity_;
+                sums.notional_ += tree_[node].notional_;
+            }
+            return sums;
+        }
+
+        // Largest count whose first count levels hold no more than quantity, out of size levels.
+        // Only valid straight after Refresh.
+        [[nodiscard]] auto Search(AggregateQuantity quantity, size_t size) const -> size_t {
+            size_t count = 0;
+            for (size_t step = std::bit_floor(size); step > 0; step >>= 1) {
+                if (count + step <= size && tree_[count + step].quantity_ <= quantity) {
+                    count += step;
+                    quantity -= tree_[count].quantity_;
+                }
+            }
+            return count;
+        }
+
+    private:
+        std::vector<Sums> tree_{Sums{}};
+        size_t            stale_{0};
+    };
+}    // namespace akuna::book
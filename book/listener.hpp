@@ -0,0 +1,100 @@
+#pragma once
+
+#include "logger.hpp"
+#include "output_writer.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // OrderBook reports events to a Listener supplied as a template parameter. Calls are made at the
+    // point each event happens, so they inline into the matching code. Accepts, fills and cancels
+    // arrive after the order itself has been updated; OnReplace arrives while the order still has its
+    // old price and quantity. A mass cancel that takes a whole price level off reports it with a single
+    // OnCancelLevel, which gets the first order of the level and the totals of all of them, instead
+    // of one OnCancel per order. OnComplete marks the end of each operation and gets the book, whose
+    // sides already reflect the whole operation. A listener provides:
+    //
+    //   template <typename OrderPtr> auto OnAccept(const OrderPtr& order) -> void;
+    //   template <typename OrderPtr> auto OnFill(const OrderPtr& order, const OrderPtr& matched_order,
+    //                                           Quantity fill_qty, Price fill_price) -> void;
+    //   template <typename OrderPtr> auto OnCancel(const OrderPtr& order, Quantity open_qty) -> void;
+    //   template <typename OrderPtr> auto OnCancelLevel(const OrderPtr& first, AggregateQuantity open_qty,
+    //                                                   uint32_t orders) -> void;
+    //   template <typename OrderPtr> auto OnReplace(const OrderPtr& order, Quantity open_qty, Delta delta,
+    //                                               Price new_price) -> void;
+    //   template <typename Book> auto OnComplete(const Book& book) -> void;
+
+    // Ignores every event; an OrderBook using it does no work beyond matching and order state.
+    struct NullListener {
+        template <typename OrderPtr>
+        auto OnAccept(const OrderPtr&) -> void {
+        }
+
+        template <typename OrderPtr>
+        auto OnFill(const OrderPtr&, const OrderPtr&, Quantity, Price) -> void {
+        }
+
+        template <typename OrderPtr>
+        auto OnCancel(const OrderPtr&, Quantity) -> void {
+        }
+
+        template <typename OrderPtr>
+        auto OnCancelLevel(const OrderPtr&, AggregateQuantity, uint32_t) -> void {
+        }
+
+        template <typename OrderPtr>
+        auto OnReplace(const OrderPtr&, Quantity, Delta, Price) -> void {
+        }
+
+        template <typename Book>
+        auto OnComplete(const Book&) -> void {
+        }
+    };
+
+    // Prints a TRADE line for every fill, through an OutputWriter when one is given and through
+    // LOG_INFO otherwise.
+    class TradeLogger {
+    public:
+        explicit TradeLogger(OutputWriter* writer = nullptr) : writer_{writer} {
+        }
+
+        template <typename OrderPtr>
+        auto OnAccept([[maybe_unused]] const OrderPtr& order) -> void {
+            LOG_DEBUG("Event: Accepted: " << *order);
+        }
+
+        template <typename OrderPtr>
+        auto OnFill(const OrderPtr& order, const OrderPtr& matched_order, Quantity fill_qty, Price) -> void {
+            if (writer_) {
+                writer_->Trade(matched_order->GetName(), matched_order->GetPrice(), order->GetName(), order->GetPrice(),
+                               fill_qty);
+            } else {
+                LOG_INFO("TRADE " << matched_order->GetName() << ' ' << matched_order->GetPrice() << ' ' << fill_qty
+                                  << ' ' << order->GetName() << ' ' << order->GetPrice() << ' ' << fill_qty);
+            }
+        }
+
+        template <typename OrderPtr>
+        auto OnCancel([[maybe_unused]] const OrderPtr& order, Quantity) -> void {
+            LOG_DEBUG("Event: Canceled: " << *order);
+        }
+
+        template <typename OrderPtr>
+        auto OnCancelLevel([[maybe_unused]] const OrderPtr& first, [[maybe_unused]] AggregateQuantity open_qty,
+                           [[maybe_unused]] uint32_t orders) -> void {
+            LOG_DEBUG("Event: Canceled level: " << first->GetPrice() << ' ' << open_qty << " over " << orders
+                                                << " orders");
+        }
+
+        template <typename OrderPtr>
+        auto OnReplace([[maybe_unused]] const OrderPtr& order, Quantity, Delta, Price) -> void {
+            LOG_DEBUG("Event: Replaced: " << *order);
+        }
+
+        template <typename Book>
+        auto OnComplete(const Book&) -> void {
+        }
+
+    private:
+        OutputWriter* writer_;
+    };
+}    // namespace akuna::book
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <span>
+
+#include "depth_level.hpp"
+#include "order_tracker.hpp"
+#include "side_traits.hpp"
+#include "stats.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // One side of the book kept in a std::multimap keyed by price rank (see side_traits.hpp), best
+    // first. Orders at equal prices are kept in arrival order, so the first entry is always the next
+    // one to match. A second map keeps the open quantity and order count of each price level.
+    // Traits is one of the side traits in side_traits.hpp.
+    template <typename OrderPtr, typename Traits>
+    class MapSide {
+    public:
+        using Tracker    = OrderTracker<OrderPtr>;
+        using TrackerMap = std::multimap<Price, Tracker, std::greater<>>;
+        using LevelMap   = std::map<Price, DepthLevel, std::greater<>>;
+        using Handle     = typename TrackerMap::iterator;
+
+        [[nodiscard]] auto Empty() const -> bool {
+            return trackers_.empty();
+        }
+
+        // limit comes from the other side's Limit.
+        [[nodiscard]] auto Matches(Price limit) const -> bool {
+            return trackers_.begin()->first >= Traits::Bound(limit);
+        }
+
+        [[nodiscard]] auto Front() -> Tracker& {
+            return trackers_.begin()->second;
+        }
+
+        // Accounts for qty traded off the front order, which the caller has already filled.
+        auto ReduceFront(Quantity qty) -> void {
+            levels_.begin()->second.quantity_ -= qty;
+            quantity_ -= qty;
+        }
+
+        auto PopFront() -> void {
+            Unlink(trackers_.begin());
+            trackers_.erase(trackers_.begin());
+        }
+
+        auto Insert(Price price, const Tracker& tracker) -> Handle {
+            const Price KEY   = Traits::Rank(price);
+            DepthLevel& level = levels_.try_emplace(KEY, DepthLevel{price, 0, 0}).first->second;
+            level.quantity_ += tracker.OpenQty();
+            ++level.orders_;
+            quantity_ += tracker.OpenQty();
+            return trackers_.insert({KEY, tracker});
+        }
+
+        [[nodiscard]] auto Find(const OrderPtr& order, Handle& result) -> bool {
+            const Price             KEY     = Traits::Rank(Traits::PriceOf(order));
+            [[maybe_unused]] size_t scanned = 0;
+
+            for (result = trackers_.find(KEY); result != trackers_.end(); ++result) {
+                ++scanned;
+                if (result->second.Ptr() == order) {
+                    STATS_RECORD(FIND_SCAN, scanned);
+                    return true;
+                } else if (result->first != KEY) {
+                    STATS_RECORD(FIND_SCAN, scanned);
+                    result = trackers_.end();
+                    return false;
+                }
+            }
+            STATS_RECORD(FIND_SCAN, scanned);
+            return false;
+        }
+
+        // Multimap iterators cannot be checked for staleness, so handles are only a hint here and
+        // the order is always looked up again.
+        [[nodiscard]] auto Locate(const OrderPtr& order, Handle& pos) -> bool {
+            return Find(order, pos);
+        }
+
+        [[nodiscard]] auto At(Handle pos) -> Tracker& {
+            return pos->second;
+        }
+
+        auto Erase(Handle pos) -> void {
+            Unlink(pos);
+            trackers_.erase(pos);
+        }
+
+        template <typename Fn>
+        auto ForEach(Fn&& fn) const -> void {
+            for (const auto& [rank, tracker] : trackers_) {
+                fn(Traits::PriceOf(tracker.Ptr()), tracker);
+            }
+        }
+
+        // Takes every level priced from low to high off the side in one pass, best first. For each
+        // level, on_order(tracker) is called for its orders in priority order, then on_level(level,
+        // first) with the level's totals and its first order.
+        template <typename OnOrder, typename OnLevel>
+        auto EraseLevels(Price low, Price high, OnOrder&& on_order, OnLevel&& on_level) -> void {
+            for (auto level = levels_.begin(); level != levels_.end();) {
+                const DepthLevel depth = level->second;
+                if (depth.price_ < low || depth.price_ > high) {
+                    ++level;
+                    continue;
+                }
+                auto     orders = trackers_.equal_range(level->first);
+                OrderPtr front  = orders.first->second.Ptr();
+                for (auto order = orders.first; order != orders.second; ++order) {
+                    on_order(order->second);
+                }
+                trackers_.erase(orders.first, orders.second);
+                quantity_ -= depth.quantity_;
+                level = levels_.erase(level);
+                on_level(depth, front);
+            }
+        }
+
+        // Takes every order for which drop(tracker) holds off the side in one pass, best first,
+        // calling on_order(tracker) for each. The orders that stay are not moved, so their handles
+        // stay valid.
+        template <typename Drop, typename OnOrder>
+        auto EraseIf(Drop&& drop, OnOrder&& on_order) -> void {
+            for (auto pos = trackers_.begin(); pos != trackers_.end();) {
+                if (!drop(pos->second)) {
+                    ++pos;
+                    continue;
+                }
+                on_order(pos->second);
+                Unlink(pos);
+                pos = trackers_.erase(pos);
+            }
+        }
+
+        [[nodiscard]] auto LevelCount() const -> size_t {
+            return levels_.size();
+        }
+
+        [[nodiscard]] auto OpenQuantity() const -> AggregateQuantity {
+            return quantity_;
+        }
+
+        [[nodiscard]] auto Best(DepthLevel& level) const -> bool {
+            return Top(std::span<DepthLevel>{&level, 1}) == 1;
+        }
+
+        [[nodiscard]] auto LevelAt(Price price, DepthLevel& level) const -> bool {
+            auto found = levels_.find(Traits::Rank(price));
+            if (found == levels_.end()) {
+                return false;
+            }
+            level = found->second;
+            return true;
+        }
+
+        // Open quantity an inbound order of the other side with the given limit could trade against.
+        // Walks every level in reach.
+        [[nodiscard]] auto QuantityWithin(Price limit) const -> AggregateQuantity {
+            AggregateQuantity quantity = 0;
+            for (auto level = levels_.begin(); level != levels_.end() && level->first >= Traits::Bound(limit); ++level) {
+                quantity += level->second.quantity_;
+            }
+            return quantity;
+        }
+
+        // Cost of taking quantity off this side, best price first, for an inbound order of the other
+        // side with the given limit. Walks the levels it takes from. Resting market orders count at
+        // price 0.
+        [[nodiscard]] auto Sweep(Price limit, Quantity quantity) const -> SweepCost {
+            SweepCost sweep;
+            for (auto level = levels_.begin();
+                 level != levels_.end() && level->first >= Traits::Bound(limit) && sweep.quantity_ < quantity; ++level) {
+                AggregateQuantity taken = std::min(level->second.quantity_, quantity - sweep.quantity_);
+                sweep.quantity_ += taken;
+                sweep.cost_ += static_cast<Cost>(level->second.price_) * taken;
+                sweep.worst_price_ = level->second.price_;
+            }
+            return sweep;
+        }
+
+        // Fills out with up to out.size() levels, best first, and returns how many were written.
+        auto Top(std::span<DepthLevel> out) const -> size_t {
+            size_t count = std::min(out.size(), levels_.size());
+            auto   level = levels_.begin();
+            for (size_t i = 0; i < count; ++i, ++level) {
+                out[i] = level->second;
+            }
+            return count;
+        }
+
+        // Visits every level, best first.
+        template <typename Fn>
+        auto ForEachLevel(Fn&& fn) const -> void {
+            for (const auto& [rank, level] : levels_) {
+                fn(level);
+            }
+        }
+
+        // Visits every level, worst first.
+        template <typename Fn>
+        auto ForEachLevelReverse(Fn&& fn) const -> void {
+            for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+                fn(level->second);
+            }
+        }
+
+    private:
+        auto Unlink(Handle pos) -> void {
+            auto level = levels_.find(pos->first);
+            level->second.quantity_ -= pos->second.OpenQty();
+            quantity_ -= pos->second.OpenQty();
+            if (--level->second.orders_ == 0) {
+                levels_.erase(level);
+            }
+        }
+
+        TrackerMap        trackers_{};
+        LevelMap          levels_{};
+        AggregateQuantity quantity_{0};
+    };
+}    // namespace akuna::book
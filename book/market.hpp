@@ -1,19 +1,145 @@
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <span>
 #include <unordered_map>
+#include <vector>
+#include <utility>
 
+#include "command.hpp"
+#include "depth_view.hpp"
+#include "feed.hpp"
+#include "feed_listener.hpp"
 #include "logger.hpp"
 #include "order.hpp"
 #include "order_book.hpp"
+#include "order_map.hpp"
+#include "pool.hpp"
+#include "stats.hpp"
+#include "timer_wheel.hpp"
 
 namespace akuna::me {
-    class Market {
+    // Hosts one OrderBook per symbol, created on first use. Order ids are unique across symbols, and
+    // an order always stays on the book of the symbol it was entered with. SideT selects the book
+    // storage; see book::OrderBook.
+    //
+    // The market keeps a clock that only moves when told to. Good-till-time orders are scheduled on
+    // a timer wheel by order id and expire as the clock passes them; a timer whose order has since
+    // gone is simply dropped when it fires. Everything else is good for the day and goes at once
+    // when the day ends.
+    //
+    // Mass cancels take whole price levels off one side of a book without going through the orders
+    // one cancel at a time. The known orders of each owner or session group are linked into a list
+    // through their index entries, so cancelling a group visits only its own orders.
+    template <template <typename, typename> class SideT = book::LadderSide>
+    class BasicMarket {
     public:
         using OrderId         = book::OrderId;
         using OrderConditions = book::OrderConditions;
-        using OrderPtr        = std::shared_ptr<book::Order>;
-        using OrderBook       = book::OrderBook<OrderPtr>;
-        using OrderMap        = std::unordered_map<OrderId, OrderPtr>;
+        using OrderPool       = book::Pool<book::Order>;
+        using OrderPtr        = typename OrderPool::Ptr;
+        using Symbol          = book::Symbol;
+        using Listener        = book::FeedListener<book::DepthListener<book::TradeLogger>>;
+        using OrderBook       = book::OrderBook<OrderPtr, SideT, Listener>;
+        using Handle          = typename OrderBook::Handle;
+
+        // Each known order is stored with its position in the book so that cancels and modifies can
+        // unlink it directly, and with its neighbours in the list of its group, if it has one.
+        struct Entry {
+            OrderPtr order_{};
+            Handle   handle_{};
+            OrderId  group_prev_{book::INVALID_ORDER_ID};
+            OrderId  group_next_{book::INVALID_ORDER_ID};
+        };
+
+        using OrderMap = book::OrderMap<Entry>;
+        using BookMap  = std::unordered_map<Symbol, OrderBook>;
+        using ViewMap  = std::unordered_map<Symbol, std::unique_ptr<book::DepthView>>;
+        using Timers   = book::TimerWheel<OrderId>;
+        using GroupMap = std::unordered_map<book::Group, OrderId>;
+
+        // Trades and book dumps are written through writer when one is given, otherwise through
+        // LOG_INFO.
+        explicit BasicMarket(book::OutputWriter* writer = nullptr) : writer_{writer} {
+        }
+
+        // Executes one decoded command and returns what OrderEntry, OrderModify or OrderCancel
+        // returned for it. Invalid commands, and modifies and cancels of ids that were never added,
+        // are ignored and return false.
+        auto Apply(const book::Command& command) -> bool {
+            if (!command.valid_) {
+                return false;
+            }
+            switch (command.msg_type_) {
+                case 'A': {
+                    OrderConditions conditions = book::OrderCondition::OC_NO_CONDITIONS;
+                    if (command.ioc_) {
+                        conditions |= book::OrderCondition::OC_IMMEDIATE_OR_CANCEL;
+                    }
+                    if (command.all_or_none_) {
+                        conditions |= book::OrderCondition::OC_ALL_OR_NONE;
+                    }
+                    return OrderEntry(NewOrder(command.order_id_, command.name_, command.is_buy_, command.quantity_,
+                                               command.price_, command.symbol_, command.stop_price_,
+                                               command.timestamp_, command.group_),
+                                      conditions);
+                }
+                case 'M':
+                    return command.order_id_ != book::INVALID_ORDER_ID &&
+                           OrderModify(NewOrder(command.order_id_, command.name_, command.is_buy_,
+                                                command.quantity_, command.price_, command.symbol_));
+                case 'X':
+                    return command.order_id_ != book::INVALID_ORDER_ID && OrderCancel(command.order_id_);
+                case 'P':
+                    Log(command.symbol_);
+                    return true;
+                case 'S':
+                    STATS_DUMP(stderr);
+                    return true;
+                case 'T':
+                    AdvanceClock(command.timestamp_);
+                    return true;
+                case 'E':
+                    EndOfDay();
+                    return true;
+                case 'C':
+                    if (command.group_ != 0) {
+                        CancelGroup(command.group_);
+                    } else {
+                        CancelLevels(command.symbol_, command.is_buy_, command.price_, command.high_price_);
+                    }
+                    return true;
+            }
+            return false;
+        }
+
+        // Applies commands in order, writing the result of each to the same position in results, and
+        // returns how many were applied; a short results buffer cuts the batch short. The order index
+        // slot of each command is prefetched a few commands ahead, which hides most of the lookup
+        // latency when the index no longer fits in cache.
+        auto Process(std::span<const book::Command> commands, std::span<bool> results) -> size_t {
+            constexpr size_t PREFETCH_DISTANCE{8};
+
+            size_t count = std::min(commands.size(), results.size());
+            for (size_t i = 0; i < std::min(count, PREFETCH_DISTANCE); ++i) {
+                orders_.Prefetch(commands[i].order_id_);
+            }
+            for (size_t i = 0; i < count; ++i) {
+                if (i + PREFETCH_DISTANCE < count) {
+                    orders_.Prefetch(commands[i + PREFETCH_DISTANCE].order_id_);
+                }
+                results[i] = Apply(commands[i]);
+            }
+            return count;
+        }
+
+        // Orders live in the market's pool and are recycled once the last reference to them is
+        // dropped, which happens when they are filled, cancelled or replaced.
+        template <typename... Args>
+        auto NewOrder(Args&&... args) -> OrderPtr {
+            return pool_.Create(std::forward<Args>(args)...);
+        }
 
         auto OrderEntry(const OrderPtr& order, OrderConditions conditions = book::OrderCondition::OC_NO_CONDITIONS)
                 -> bool {
@@ -22,101 +148,400 @@ namespace akuna::me {
             }
             LOG_DEBUG("ADDING order: " << *order);
             auto order_id = order->GetOrderId();
-            bool inserted = AddOrder(order);
+            auto [entry, inserted] = orders_.TryEmplace(order_id, Entry{order});
+            if (inserted) {
+                Link(order_id, *entry);
+            }
 
-            if (inserted && book_.Add(order, conditions)) {
+            OrderBook& book = Book(order->GetSymbol());
+            if (inserted && book.Add(order, conditions, entry->handle_)) {
                 LOG_DEBUG(order_id << " matched");
-                for (const auto& matched_order_id : order->GetTrades()) {
-                    auto matched_order = GetOrder(matched_order_id);
-                    if (RemoveOrder(matched_order)) {
-                        LOG_DEBUG("REMOVED order: " << *matched_order);
-                    }
-                }
-                if (RemoveOrder(order)) {
-                    LOG_DEBUG("REMOVED order: " << *order);
-                }
+                RemoveFilled(book, order);
+            } else if (inserted) {
+                RemoveTriggered(book);
+            }
+            if (inserted && order->GetExpiry() != 0 && orders_.Contains(order_id)) {
+                timers_.Schedule(order->GetExpiry(), order_id);
             }
             return inserted;
         }
 
         auto OrderModify(const OrderPtr& order) -> bool {
-            bool result = false;
-            if (!OrderModifyValidate(order)) {
+            bool result   = false;
+            auto order_id = order->GetOrderId();
+            auto entry    = orders_.Find(order_id);
+            if (entry == nullptr) {
+                return result;
+            }
+            auto passivated_order = entry->order_;
+            // A modify keeps the symbol of the order, the stop of one that has not triggered yet, its
+            // expiry and its group. Modifies carry no symbol of their own.
+            order->SetSymbol(passivated_order->GetSymbol());
+            order->SetStopPrice(passivated_order->GetStopPrice());
+            order->SetExpiry(passivated_order->GetExpiry());
+            order->SetGroup(passivated_order->GetGroup());
+            if (!Validate(order)) {
                 return result;
             }
-            auto order_id         = order->GetOrderId();
-            auto passivated_order = GetOrder(order_id);
             LOG_DEBUG("MODIFYING passivated order: " << *passivated_order << " with order: " << *order);
-            if (book_.Replace(passivated_order, order)) {
-                for (const auto& matched_order_id : order->GetTrades()) {
-                    auto matched_order = GetOrder(matched_order_id);
-                    if (RemoveOrder(matched_order)) {
-                        LOG_DEBUG("REMOVED order: " << *matched_order);
-                    }
+            entry->order_ = order;
+            OrderBook& book = Book(passivated_order->GetSymbol());
+            if (book.Replace(passivated_order, order, entry->handle_)) {
+                RemoveFilled(book, order);
+            } else {
+                RemoveTriggered(book);
+            }
+            return !result;
+        }
+
+        auto OrderCancel(OrderId order_id) -> bool {
+            Entry entry;
+            if (!orders_.Extract(order_id, entry)) {
+                return false;
+            }
+            Unlink(entry);
+            LOG_DEBUG("Requesting Cancel: " << *entry.order_);
+            Book(entry.order_->GetSymbol()).Cancel(entry.order_, entry.handle_);
+            return true;
+        }
+
+        // Reinstates a known order, putting it on its book with open_qty left when resting. Returns
+        // false when the id is already taken.
+        auto RestoreOrder(const OrderPtr& order, bool resting, book::Quantity open_qty) -> bool {
+            auto [entry, inserted] = orders_.TryEmplace(order->GetOrderId(), Entry{order});
+            if (inserted) {
+                Link(order->GetOrderId(), *entry);
+            }
+            if (inserted && resting) {
+                entry->handle_ = Book(order->GetSymbol()).Restore(order, open_qty);
+            }
+            if (inserted && order->GetExpiry() > timers_.Now()) {
+                timers_.Schedule(order->GetExpiry(), order->GetOrderId());
+            }
+            return inserted;
+        }
+
+        // Sets the last trade price of symbol's book, which decides when its stops trigger. Used to
+        // reload snapshots before their orders are restored.
+        auto RestoreMarketPrice(Symbol symbol, book::Price price) -> void {
+            Book(symbol).MarketPrice(price);
+        }
+
+        [[nodiscard]] auto Clock() const -> book::Timestamp {
+            return timers_.Now();
+        }
+
+        // Moves the clock forward to now and cancels every good-till-time order that has expired by
+        // then, earliest first. Costs O(orders expired) however far the clock moves.
+        auto AdvanceClock(book::Timestamp now) -> void {
+            timers_.Advance(now, [this](book::Timestamp expiry, OrderId order_id) {
+                auto entry = orders_.Find(order_id);
+                if (entry != nullptr && entry->order_->GetExpiry() == expiry) {
+                    LOG_DEBUG("EXPIRING order: " << *entry->order_);
+                    OrderCancel(order_id);
                 }
-                if (RemoveOrder(order)) {
-                    LOG_DEBUG("REMOVED order: " << *order);
+            });
+        }
+
+        // Ends the trading day: every order without an expiry goes, whether resting, parked or
+        // already done. Each book takes them off in one pass over each side, leaving its good-till-time
+        // orders where they rest, and the order index is rebuilt in one pass too, rather than
+        // cancelling order by order.
+        auto EndOfDay() -> void {
+            Purge([](const OrderPtr& order) { return order->GetExpiry() == 0; });
+        }
+
+        // Cancels every order on the given side of symbol's book priced from low to high, and every
+        // stop of that side whose stop price lies in that range, a whole price level at a time.
+        // Returns how many orders went.
+        auto CancelLevels(Symbol symbol, bool buy_side, book::Price low = 0,
+                          book::Price high = std::numeric_limits<book::Price>::max()) -> size_t {
+            auto book = books_.find(symbol);
+            if (book == books_.end()) {
+                return 0;
+            }
+            size_t count = 0;
+            book->second.CancelLevels(buy_side, low, high, [this, &count](const OrderPtr& order) {
+                count += RemoveOrder(order->GetOrderId()) ? 1 : 0;
+            });
+            return count;
+        }
+
+        // Cancels every order tagged with group, whether resting, parked or done. The group's list
+        // is taken out of the order index and each order goes straight off its book through its
+        // handle, one operation per book, so the cost is O(orders in the group). Returns how many
+        // orders went.
+        auto CancelGroup(book::Group group) -> size_t {
+            auto head = groups_.find(group);
+            if (head == groups_.end()) {
+                return 0;
+            }
+            for (OrderId order_id = head->second; order_id != book::INVALID_ORDER_ID;) {
+                Entry entry;
+                orders_.Extract(order_id, entry);
+                order_id = entry.group_next_;
+                cancelled_.push_back(std::move(entry));
+            }
+            groups_.erase(head);
+
+            auto by_symbol = [](const Entry& lhs, const Entry& rhs) {
+                return lhs.order_->GetSymbol() < rhs.order_->GetSymbol();
+            };
+            std::stable_sort(cancelled_.begin(), cancelled_.end(), by_symbol);
+            for (auto first = cancelled_.begin(); first != cancelled_.end();) {
+                auto last = std::upper_bound(first, cancelled_.end(), *first, by_symbol);
+                LOG_DEBUG("Requesting Cancel of group " << group << " on symbol " << first->order_->GetSymbol());
+                Book(first->order_->GetSymbol()).CancelAll(std::span<const Entry>(first, last));
+                first = last;
+            }
+            size_t count = cancelled_.size();
+            cancelled_.clear();
+            return count;
+        }
+
+        // Calls fn(order, resting, open_qty) for every known order: first the resting ones, by
+        // symbol, bids, asks, buy stops then sell stops, each in priority order, then the rest by id.
+        // The order depends only on the state of the market, not on how it was reached.
+        template <typename Fn>
+        auto ForEachOrder(Fn&& fn) const -> void {
+            std::vector<Symbol> symbols;
+            for (const auto& [symbol, book] : books_) {
+                symbols.push_back(symbol);
+            }
+            std::sort(symbols.begin(), symbols.end());
+            auto resting = [&fn](book::Price, const typename OrderBook::Tracker& tracker) {
+                fn(tracker.Ptr(), true, tracker.OpenQty());
+            };
+            for (auto symbol : symbols) {
+                const OrderBook& book = books_.at(symbol);
+                book.GetBids().ForEach(resting);
+                book.GetAsks().ForEach(resting);
+                book.GetBuyStops().ForEach(resting);
+                book.GetSellStops().ForEach(resting);
+            }
+
+            std::vector<OrderPtr> others;
+            orders_.ForEach([&others](OrderId, const Entry& entry) {
+                if (entry.order_->QuantityOnMarket() == 0) {
+                    others.push_back(entry.order_);
                 }
+            });
+            std::sort(others.begin(), others.end(), [](const OrderPtr& lhs, const OrderPtr& rhs) {
+                return lhs->GetOrderId() < rhs->GetOrderId();
+            });
+            for (const auto& order : others) {
+                fn(order, false, book::Quantity{0});
             }
-            if (FoundExistingOrder(order_id)) {
-                orders_.at(order_id) = order;
+        }
+
+        // Calls fn(symbol, price) for every book that has traded, with its last trade price, in symbol
+        // order.
+        template <typename Fn>
+        auto ForEachMarketPrice(Fn&& fn) const -> void {
+            std::vector<std::pair<Symbol, book::Price>> prices;
+            for (const auto& [symbol, book] : books_) {
+                if (book.GetMarketPrice() != book::MARKET_ORDER_PRICE) {
+                    prices.emplace_back(symbol, book.GetMarketPrice());
+                }
+            }
+            std::sort(prices.begin(), prices.end());
+            for (const auto& [symbol, price] : prices) {
+                fn(symbol, price);
+            }
+        }
+
+        // Redirects trades and book dumps, e.g. to silence a journal replay. Output already handed to
+        // the old writer is not flushed.
+        auto SetWriter(book::OutputWriter* writer) -> void {
+            writer_ = writer;
+            for (auto& [symbol, book] : books_) {
+                book.GetListener() = MakeListener(symbol);
+            }
+        }
+
+        // Publishes every book event from now on to feed, or stops publishing when it is null.
+        auto SetFeed(book::FeedWriter* feed) -> void {
+            feed_ = feed;
+            for (auto& [symbol, book] : books_) {
+                book.GetListener() = MakeListener(symbol);
             }
-            return !result;
         }
 
-        auto OrderCancel(const OrderId& order_id) -> bool {
-            bool result = false;
-            auto order  = GetOrder(order_id);
-            if (order) {
-                LOG_DEBUG("Requesting Cancel: " << *order);
-                book_.Cancel(order);
-                result = RemoveOrder(order_id);
+        // Publishes the top of symbol's book after every operation on it, starting with its current
+        // state, to readers on any thread through the returned view, which lives as long as the
+        // market. Must not be called while another thread is running the market.
+        auto PublishDepth(Symbol symbol) -> const book::DepthView& {
+            auto& view = views_[symbol];
+            if (view == nullptr) {
+                view = std::make_unique<book::DepthView>();
             }
-            return result;
+            OrderBook& book    = Book(symbol);
+            book.GetListener() = MakeListener(symbol);
+            book.GetListener().GetInner().Publish(book);
+            return *view;
+        }
+
+        [[nodiscard]] auto Contains(OrderId order_id) const -> bool {
+            return orders_.Contains(order_id);
+        }
+
+        // Returns nullptr when nothing has been entered for symbol yet.
+        [[nodiscard]] auto GetBook(Symbol symbol = book::DEFAULT_SYMBOL) const -> const OrderBook* {
+            auto book = books_.find(symbol);
+            return book == books_.end() ? nullptr : &book->second;
+        }
+
+        // See OrderBook::Sweep; an unknown symbol has nothing to sweep.
+        [[nodiscard]] auto Sweep(Symbol symbol, bool buy_side, book::Quantity quantity,
+                                 book::Price limit = book::MARKET_ORDER_PRICE) const -> book::SweepCost {
+            const OrderBook* book = GetBook(symbol);
+            return book == nullptr ? book::SweepCost{} : book->Sweep(buy_side, quantity, limit);
         }
 
-        auto Log() const -> void {
-            book_.Log();
+        auto Log(Symbol symbol = book::DEFAULT_SYMBOL) -> void {
+            Book(symbol).Log(writer_);
         }
 
     private:
-        [[nodiscard]] auto Validate(const OrderPtr& order) -> bool {
-            return order->GetPrice() != 0;
+        // Consecutive commands nearly always hit the same symbol, so the last book is cached.
+        auto Book(Symbol symbol) -> OrderBook& {
+            if (last_book_ == nullptr || symbol != last_symbol_) {
+                last_book_   = &books_.try_emplace(symbol, MakeListener(symbol)).first->second;
+                last_symbol_ = symbol;
+            }
+            return *last_book_;
         }
 
-        [[nodiscard]] auto OrderModifyValidate(const OrderPtr& order) -> bool {
-            return Validate(order) && FoundExistingOrder(order->GetOrderId());
+        [[nodiscard]] auto MakeListener(Symbol symbol) const -> Listener {
+            auto view = views_.find(symbol);
+            return Listener{book::DepthListener<book::TradeLogger>{book::TradeLogger{writer_},
+                                                                   view == views_.end() ? nullptr : view->second.get()},
+                            feed_};
         }
 
-        [[nodiscard]] auto GetOrder(const OrderId& order_id) -> OrderPtr {
-            if (FoundExistingOrder(order_id)) {
-                return orders_.at(order_id);
+        // Only stops may come without a price; they enter as market orders when they trigger. An
+        // expiry must still lie ahead.
+        [[nodiscard]] auto Validate(const OrderPtr& order) -> bool {
+            return (order->GetPrice() != 0 || order->IsStop()) &&
+                   (order->GetExpiry() == 0 || order->GetExpiry() > timers_.Now());
+        }
+
+        [[nodiscard]] auto GetOrder(OrderId order_id) -> OrderPtr {
+            auto entry = orders_.Find(order_id);
+            if (entry != nullptr) {
+                return entry->order_;
             }
             return {};
         }
 
-        [[nodiscard]] auto FoundExistingOrder(const OrderId& order_id) -> bool {
-            return orders_.find(order_id) != orders_.end();
+        // Cancels every order for which drop(order) holds: each book takes them off in one pass over
+        // its sides, then the order index is rebuilt. Orders that belong to a group leave the
+        // index one by one first, so that their group's list stays linked. Returns how many orders
+        // went.
+        template <typename Drop>
+        auto Purge(Drop&& drop) -> size_t {
+            for (auto& [symbol, book] : books_) {
+                book.Purge(drop);
+            }
+            orders_.ForEach([&](OrderId, const Entry& entry) {
+                if (entry.order_->GetGroup() != 0 && drop(entry.order_)) {
+                    cancelled_.push_back(entry);
+                }
+            });
+            size_t count = 0;
+            for (const Entry& entry : cancelled_) {
+                count += RemoveOrder(entry.order_->GetOrderId()) ? 1 : 0;
+            }
+            cancelled_.clear();
+            return count + orders_.EraseIf([&drop](OrderId, const Entry& entry) { return drop(entry.order_); });
         }
 
-        [[nodiscard]] auto AddOrder(const OrderPtr& order) -> bool {
-            const auto& order_id = order->GetOrderId();
-            bool        inserted = false;
-            if (!FoundExistingOrder(order_id)) {
-                inserted = orders_.insert({order_id, order}).second;
+        // Puts a newly known order at the front of its group's list.
+        auto Link(OrderId order_id, Entry& entry) -> void {
+            book::Group group = entry.order_->GetGroup();
+            if (group == 0) {
+                return;
             }
-            return inserted;
+            OrderId& head     = groups_.try_emplace(group, book::INVALID_ORDER_ID).first->second;
+            entry.group_next_ = head;
+            if (head != book::INVALID_ORDER_ID) {
+                orders_.Find(head)->group_prev_ = order_id;
+            }
+            head = order_id;
         }
 
-        [[nodiscard]] auto RemoveOrder(const OrderId& order_id) -> bool {
-            return orders_.erase(order_id) == 1;
+        // Takes an order that is leaving the index out of its group's list, dropping the list once
+        // it is empty. Its neighbours must still be in the index.
+        auto Unlink(const Entry& entry) -> void {
+            book::Group group = entry.order_->GetGroup();
+            if (group == 0) {
+                return;
+            }
+            if (entry.group_prev_ != book::INVALID_ORDER_ID) {
+                orders_.Find(entry.group_prev_)->group_next_ = entry.group_next_;
+            } else if (entry.group_next_ != book::INVALID_ORDER_ID) {
+                groups_[group] = entry.group_next_;
+            } else {
+                groups_.erase(group);
+            }
+            if (entry.group_next_ != book::INVALID_ORDER_ID) {
+                orders_.Find(entry.group_next_)->group_prev_ = entry.group_prev_;
+            }
+        }
+
+        // Forgets the resting orders the last operation on book filled completely, then order itself
+        // if it is done too.
+        auto RemoveFilled(const OrderBook& book, const OrderPtr& order) -> void {
+            for (const book::Fill& fill : book.GetFills()) {
+                auto matched_order = GetOrder(fill.maker_);
+                if (RemoveOrder(matched_order)) {
+                    LOG_DEBUG("REMOVED order: " << *matched_order);
+                }
+            }
+            RemoveTriggered(book);
+            if (RemoveOrder(order)) {
+                LOG_DEBUG("REMOVED order: " << *order);
+            }
+        }
+
+        // Moves the stops the last operation on book released to where they now rest, and forgets
+        // those that did not come to rest.
+        auto RemoveTriggered(const OrderBook& book) -> void {
+            for (const auto& triggered : book.GetTriggered()) {
+                if (RemoveOrder(triggered.order_)) {
+                    LOG_DEBUG("REMOVED order: " << *triggered.order_);
+                } else if (auto entry = orders_.Find(triggered.order_->GetOrderId()); entry != nullptr) {
+                    entry->handle_ = triggered.handle_;
+                }
+            }
+        }
+
+        [[nodiscard]] auto RemoveOrder(OrderId order_id) -> bool {
+            Entry entry;
+            if (!orders_.Extract(order_id, entry)) {
+                return false;
+            }
+            Unlink(entry);
+            return true;
         }
 
         [[nodiscard]] auto RemoveOrder(const OrderPtr& order) -> bool {
+            STATS_TIMER(REMOVE);
             return order && order->QuantityOnMarket() == 0 && RemoveOrder(order->GetOrderId());
         }
 
-        OrderMap  orders_{};
-        OrderBook book_{};
+        OrderPool           pool_{};
+        OrderMap            orders_{};
+        GroupMap            groups_{};
+        std::vector<Entry>  cancelled_{};
+        BookMap             books_{};
+        ViewMap             views_{};
+        Timers              timers_{};
+        OrderBook*          last_book_{nullptr};
+        Symbol              last_symbol_{book::DEFAULT_SYMBOL};
+        book::OutputWriter* writer_;
+        book::FeedWriter*   feed_{nullptr};
     };
+
+    using Market = BasicMarket<>;
 }    // namespace akuna::me
\ No newline at end of file
@@ -3,26 +3,39 @@
 #include <optional>
 #include <ostream>
 #include <sstream>
-#include <string>
-#include <utility>
-#include <vector>
+#include <string_view>
 
 #include "types.hpp"
 
 namespace akuna::book {
     class Order {
     public:
-        using Trades = std::vector<OrderId>;
-
-        Order(OrderId id, bool buy_side, Quantity quantity, Price price)
-            : id_{std::move(id)}, buy_side_{buy_side}, quantity_{quantity}, price_{price} {
-            trades_.reserve(8);
+        // name is the external id the order was interned from; it is only used for output and must
+        // outlive the order. A non-zero stop_price makes a stop order, which waits off the book until
+        // the last trade price reaches it and then enters at price, or at market when price is 0. A
+        // non-zero expiry makes the order good till that time; without one it is good for the day.
+        // group tags the order with its owner or session so that they can be cancelled together.
+        Order(OrderId id, std::string_view name, bool buy_side, Quantity quantity, Price price,
+              Symbol symbol = DEFAULT_SYMBOL, Price stop_price = 0, Timestamp expiry = 0, Group group = 0)
+            : price_{price},
+              quantity_{quantity},
+              id_{id},
+              stop_price_{stop_price},
+              buy_side_{buy_side},
+              group_{group},
+              symbol_{symbol},
+              expiry_{expiry},
+              name_{name} {
         }
 
         [[nodiscard]] auto GetOrderId() const -> OrderId {
             return id_;
         }
 
+        [[nodiscard]] auto GetName() const -> std::string_view {
+            return name_;
+        }
+
         [[nodiscard]] auto IsBuy() const -> bool {
             return buy_side_;
         }
@@ -31,10 +44,23 @@ namespace akuna::book {
             return symbol_;
         }
 
+        auto SetSymbol(Symbol symbol) -> void {
+            symbol_ = symbol;
+        }
+
         [[nodiscard]] auto GetPrice() const -> Price {
             return price_;
         }
 
+        [[nodiscard]] auto GetStopPrice() const -> Price {
+            return stop_price_;
+        }
+
+        // True while the order is a stop that has not triggered yet.
+        [[nodiscard]] auto IsStop() const -> bool {
+            return stop_price_ != 0;
+        }
+
         [[nodiscard]] auto GetQuantity() const -> Quantity {
             return quantity_;
         }
@@ -47,10 +73,6 @@ namespace akuna::book {
             return quantity_filled_;
         }
 
-        [[nodiscard]] auto GetTrades() const -> const Trades & {
-            return trades_;
-        }
-
         auto OnAccepted() -> void {
             quantity_on_market_ = quantity_;
         }
@@ -60,14 +82,41 @@ namespace akuna::book {
             quantity_filled_ += fill_qty;
         }
 
-        auto AddTradeHistory(const OrderId &matched_order_id) -> void {
-            trades_.emplace_back(matched_order_id);
+        // A triggered stop carries on as a plain order.
+        auto OnTriggered() -> void {
+            stop_price_ = 0;
+        }
+
+        auto SetStopPrice(Price stop_price) -> void {
+            stop_price_ = stop_price;
+        }
+
+        [[nodiscard]] auto GetExpiry() const -> Timestamp {
+            return expiry_;
+        }
+
+        auto SetExpiry(Timestamp expiry) -> void {
+            expiry_ = expiry;
+        }
+
+        [[nodiscard]] auto GetGroup() const -> Group {
+            return group_;
+        }
+
+        auto SetGroup(Group group) -> void {
+            group_ = group;
         }
 
         auto OnCancelled() -> void {
             quantity_on_market_ = 0;
         }
 
+        // Reinstates the fill state of an order loaded from a snapshot.
+        auto Restore(Quantity quantity_filled, Quantity quantity_on_market) -> void {
+            quantity_filled_    = quantity_filled;
+            quantity_on_market_ = quantity_on_market;
+        }
+
         auto OnReplaced(const Delta &size_delta, Price new_price) -> void {
             quantity_ += size_delta;
             quantity_on_market_ += size_delta;
@@ -75,7 +124,7 @@ namespace akuna::book {
         }
 
         friend auto operator<<(std::ostream &os, const Order &order) -> std::ostream & {
-            os << "[#" << order.GetOrderId();
+            os << "[#" << order.GetName();
             os << ' ' << (order.IsBuy() ? "BUY" : "SELL");
             os << ' ' << order.GetSymbol();
             os << ' ' << order.GetQuantity();
@@ -84,6 +133,15 @@ namespace akuna::book {
             } else {
                 os << " $" << order.GetPrice();
             }
+            if (order.IsStop()) {
+                os << " STOP $" << order.GetStopPrice();
+            }
+            if (order.GetExpiry() != 0) {
+                os << " GTT " << order.GetExpiry();
+            }
+            if (order.GetGroup() != 0) {
+                os << " GROUP " << order.GetGroup();
+            }
 
             auto on_market = order.QuantityOnMarket();
             if (on_market != 0) {
@@ -101,13 +159,18 @@ namespace akuna::book {
         }
 
     private:
-        OrderId  id_{0};
-        bool     buy_side_{};
-        Symbol   symbol_{DEFAULT_SYMBOL};
-        Quantity quantity_{0};
-        Price    price_{0};
-        Quantity quantity_filled_{0};
-        Quantity quantity_on_market_{0};
-        Trades   trades_{};
+        // Fields used while matching come first and share the order's first cache line with the
+        // pool's reference count; the name is only read when reporting.
+        Price            price_{0};
+        Quantity         quantity_{0};
+        Quantity         quantity_on_market_{0};
+        Quantity         quantity_filled_{0};
+        OrderId          id_{INVALID_ORDER_ID};
+        Price            stop_price_{0};
+        bool             buy_side_{};
+        Group            group_{0};
+        Symbol           symbol_{DEFAULT_SYMBOL};
+        Timestamp        expiry_{0};
+        std::string_view name_{};
     };
 }    // namespace akuna::book
\ No newline at end of file
@@ -1,259 +1,559 @@
 #pragma once
 
-#include <list>
-#include <map>
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#include "callback.hpp"
+#include "fill.hpp"
+#include "ladder_side.hpp"
+#include "listener.hpp"
 #include "logger.hpp"
+#include "map_side.hpp"
 #include "order_tracker.hpp"
+#include "output_writer.hpp"
+#include "side_traits.hpp"
+#include "stats.hpp"
 #include "types.hpp"
 
 namespace akuna::book {
-    template <typename OrderPtr>
+    // The storage for each side is pluggable: LadderSide keeps contiguous price levels and is the
+    // default, MapSide keeps the original std::multimap so the two can be compared. Bids and asks are
+    // separate instantiations with their price ordering fixed at compile time; the side of an order
+    // is looked at once per operation, after which the code works on concrete side types. Events go
+    // to Listener as they happen; see listener.hpp.
+    //
+    // Stop orders wait in a trigger index per side, kept in the same side storage ordered by stop
+    // price, so the next stop to trigger is always at the front and checking for triggers costs the
+    // same however many are parked. Once the fills of an operation have moved the last trade price,
+    // every stop it reached is released into matching, and so on while the released orders move it
+    // further. Parked stops are invisible to the listener until they trigger.
+    template <typename OrderPtr, template <typename, typename> class SideT = LadderSide,
+              typename Listener = TradeLogger>
     class OrderBook {
     public:
-        using Tracker       = OrderTracker<OrderPtr>;
-        using TypedCallback = Callback<OrderPtr>;
-        using TrackerMap    = std::multimap<ComparablePrice, Tracker>;
-        using Callbacks     = std::vector<TypedCallback>;
+        using Tracker = OrderTracker<OrderPtr>;
+        using Bids    = SideT<OrderPtr, BidSide>;
+        using Asks    = SideT<OrderPtr, AskSide>;
+        using Handle  = typename Bids::Handle;
 
-        explicit OrderBook() {
-            callbacks_.reserve(8);
+        using BuyStops  = SideT<OrderPtr, BuyStopSide>;
+        using SellStops = SideT<OrderPtr, SellStopSide>;
+
+        static_assert(std::is_same_v<Handle, typename Asks::Handle>);
+
+        // A stop released by the last operation and where it now rests, if it does.
+        struct Triggered {
+            OrderPtr order_;
+            Handle   handle_;
+        };
+
+        explicit OrderBook(Listener listener = Listener{}) : listener_{std::move(listener)} {
+            fills_.reserve(64);
         }
 
         [[nodiscard]] auto Add(const OrderPtr &order, OrderConditions conditions) -> bool {
-            bool matched = false;
+            Handle handle{};
+            return Add(order, conditions, handle);
+        }
 
-            if (order->GetQuantity() <= 0) {
-                LOG_DEBUG(*order << " size must be positive");
-            } else {
-                size_t accept_cb_index = callbacks_.size();
-                callbacks_.push_back(TypedCallback::Accept(order));
-                Tracker inbound(order, conditions);
-                matched                               = SubmitOrder(inbound);
-                callbacks_[accept_cb_index].quantity_ = inbound.FilledQty();
-                if (inbound.ImmediateOrCancel() && !inbound.Filled()) {
-                    callbacks_.push_back(TypedCallback::Cancel(order, 0));
-                }
-            }
-            CallbackNow();
+        // Any quantity left resting, or a stop left parked, is reported through handle, which lets
+        // Cancel and Replace reach the order directly instead of searching its price level.
+        [[nodiscard]] auto Add(const OrderPtr &order, OrderConditions conditions, Handle &handle) -> bool {
+            STATS_TIMER(ADD);
+            fills_.clear();
+            triggered_.clear();
+            bool matched = Place(order, conditions, handle);
+            Complete();
             return matched;
         }
 
         auto Cancel(const OrderPtr &order) -> void {
-            bool     found    = false;
-            Quantity open_qty = 0;
-
-            if (order->IsBuy()) {
-                typename TrackerMap::iterator bid;
-                if (FindOnMarket(order, bid) && bid != bids_.end()) {
-                    open_qty = bid->second.OpenQty();
-                    bids_.erase(bid);
-                    found = true;
-                }
-            } else {
-                typename TrackerMap::iterator ask;
-                if (FindOnMarket(order, ask) && ask != asks_.end()) {
-                    open_qty = ask->second.OpenQty();
-                    asks_.erase(ask);
-                    found = true;
-                }
-            }
-            if (found) {
-                callbacks_.push_back(TypedCallback::Cancel(order, open_qty));
-            } else {
-                LOG_DEBUG(*order << " not found");
+            Handle pos;
+            bool   found = FindOnMarket(order, pos);
+            CancelOnMarket(order, found, pos);
+        }
+
+        auto Cancel(const OrderPtr &order, Handle handle) -> void {
+            bool found = LocateOnMarket(order, handle);
+            CancelOnMarket(order, found, handle);
+        }
+
+        // Cancels every element of orders, each with an order_ and the handle_ it was reported at, as
+        // one operation that completes once, e.g. for a mass cancel.
+        template <typename Orders>
+        auto CancelAll(const Orders &orders) -> void {
+            STATS_TIMER(CANCEL);
+            fills_.clear();
+            triggered_.clear();
+            for (const auto &entry : orders) {
+                Handle pos   = entry.handle_;
+                bool   found = LocateOnMarket(entry.order_, pos);
+                Withdraw(entry.order_, found, pos);
             }
-            CallbackNow();
+            Complete();
         }
 
         [[nodiscard]] auto Replace(const OrderPtr &passivated_order, const OrderPtr &new_order) -> bool {
-            bool                          matched = false;
-            TrackerMap &                  market  = passivated_order->IsBuy() ? bids_ : asks_;
-            typename TrackerMap::iterator pos;
-
-            if (passivated_order->IsBuy() != new_order->IsBuy()) {
-                if (FindOnMarket(passivated_order, pos)) {
-                    market.erase(pos);
-                    matched = Add(new_order, book::OrderCondition::OC_NO_CONDITIONS);
-                } else {
-                    LOG_DEBUG(*new_order << "not found");
-                }
-            } else {
-                if (FindOnMarket(passivated_order, pos)) {
-                    callbacks_.push_back(TypedCallback::Accept(new_order));
-                    callbacks_.push_back(TypedCallback::Replace(passivated_order, pos->second.OpenQty(), new_order));
-                    market.erase(pos);
-                    Tracker inbound(new_order, book::OrderCondition::OC_NO_CONDITIONS);
-                    matched = AddOrder(inbound, new_order->GetPrice());
-                } else {
-                    LOG_DEBUG(*new_order << "not found");
-                }
-            }
+            Handle pos;
+            bool   found = FindOnMarket(passivated_order, pos);
+            return ReplaceOnMarket(passivated_order, new_order, found, pos);
+        }
 
-            CallbackNow();
-            return matched;
+        // handle is the position of passivated_order on entry and the position of new_order on return.
+        [[nodiscard]] auto Replace(const OrderPtr &passivated_order, const OrderPtr &new_order, Handle &handle)
+                -> bool {
+            bool found = LocateOnMarket(passivated_order, handle);
+            return ReplaceOnMarket(passivated_order, new_order, found, handle);
+        }
+
+        // Cancels every resting or parked order for which drop(order) holds, e.g. at the end of the
+        // day, in one pass over each side. The orders that stay are not moved, so their handles stay
+        // valid.
+        template <typename Drop>
+        auto Purge(Drop &&drop) -> void {
+            fills_.clear();
+            triggered_.clear();
+            PurgeSide(bids_, drop, false);
+            PurgeSide(asks_, drop, false);
+            PurgeSide(buy_stops_, drop, true);
+            PurgeSide(sell_stops_, drop, true);
+            Complete();
+        }
+
+        // Cancels every order resting on the given side priced from low to high, and every stop of
+        // that side whose stop price lies in that range. Each price level is taken off in one step and
+        // reported with a single OnCancelLevel; stops leave without an event, as they arrived.
+        // cancelled(order) is called for every order that goes.
+        template <typename Cancelled>
+        auto CancelLevels(bool buy_side, Price low, Price high, Cancelled &&cancelled) -> void {
+            STATS_TIMER(CANCEL);
+            fills_.clear();
+            triggered_.clear();
+            auto on_order = [&cancelled](const Tracker &tracker) {
+                tracker.Ptr()->OnCancelled();
+                cancelled(tracker.Ptr());
+            };
+            WithSides(buy_side, [&](auto &own, auto &) {
+                own.EraseLevels(low, high, on_order, [this](const DepthLevel &level, const OrderPtr &first) {
+                    listener_.OnCancelLevel(first, level.quantity_, level.orders_);
+                });
+            });
+            WithStops(buy_side, [&](auto &stops) {
+                stops.EraseLevels(low, high, on_order, [](const DepthLevel &, const OrderPtr &) {});
+            });
+            Complete();
+        }
+
+        // Puts order at the back of its price level, or of its stop level when it is a stop, with
+        // open_qty left, without matching or events. Used to reload snapshots, which list each side
+        // in priority order.
+        auto Restore(const OrderPtr &order, Quantity open_qty) -> Handle {
+            Tracker tracker(order);
+            tracker.Fill(order->GetQuantity() - open_qty);
+            if (order->IsStop()) {
+                return WithStops(order->IsBuy(), [&](auto &stops) { return stops.Insert(order->GetStopPrice(), tracker); });
+            }
+            return WithSides(order->IsBuy(), [&](auto &own, auto &) { return own.Insert(order->GetPrice(), tracker); });
         }
 
         auto MarketPrice(Price price) -> void {
             market_price_ = price;
         }
 
-        auto MatchOrder(Tracker &inbound, Price inbound_price, TrackerMap &current_orders) -> bool {
-            bool matched = false;
-            auto pos     = current_orders.begin();
-            while (pos != current_orders.end() && !inbound.Filled()) {
-                auto                   entry         = pos++;
-                const ComparablePrice &current_price = entry->first;
-                if (!current_price.Matches(inbound_price)) {
+        // limit is the inbound order's Limit price on its own side.
+        template <typename Contra>
+        auto MatchOrder(Tracker &inbound, Price limit, Contra &current_orders) -> bool {
+            STATS_TIMER(MATCH);
+            bool                    matched = false;
+            [[maybe_unused]] size_t touched = 0;
+            [[maybe_unused]] size_t levels  = 0;
+            [[maybe_unused]] Price  level_price{MARKET_ORDER_PRICE};
+            while (!current_orders.Empty() && !inbound.Filled()) {
+                if (!current_orders.Matches(limit)) {
                     break;
                 }
 
-                Tracker &current_order = entry->second;
+                Tracker &current_order = current_orders.Front();
                 Quantity traded        = CreateTrade(inbound, current_order);
-                if (traded > 0) {
-                    matched = true;
-                    if (current_order.Filled()) {
-                        current_orders.erase(entry);
-                    }
+                if (traded == 0) {
+                    break;
+                }
+                if (touched++ == 0 || current_order.Ptr()->GetPrice() != level_price) {
+                    level_price = current_order.Ptr()->GetPrice();
+                    ++levels;
+                }
+                matched = true;
+                current_orders.ReduceFront(traded);
+                if (current_order.Filled()) {
+                    current_orders.PopFront();
                 }
             }
+            STATS_RECORD(ORDERS_TOUCHED, touched);
+            STATS_RECORD(LEVELS_WALKED, levels);
             return matched;
         }
 
-        auto CreateTrade(Tracker &inbound_tracker, Tracker &current_tracker, Quantity max_quantity = UINT64_MAX)
-                -> Quantity {
+        auto CreateTrade(Tracker &inbound_tracker, Tracker &current_tracker,
+                         Quantity max_quantity = std::numeric_limits<Quantity>::max()) -> Quantity {
             Quantity fill_qty = std::min(max_quantity, std::min(inbound_tracker.OpenQty(), current_tracker.OpenQty()));
             if (fill_qty > 0) {
                 inbound_tracker.Fill(fill_qty);
                 current_tracker.Fill(fill_qty);
-                MarketPrice(market_price_);
-                callbacks_.push_back(
-                        TypedCallback::Fill(inbound_tracker.Ptr(), current_tracker.Ptr(), fill_qty, market_price_));
+                // Resting market orders have no price of their own; they trade at the inbound one.
+                Price price = current_tracker.Ptr()->GetPrice();
+                if (price == MARKET_ORDER_PRICE) {
+                    price = inbound_tracker.Ptr()->GetPrice();
+                }
+                if (price != MARKET_ORDER_PRICE) {
+                    MarketPrice(price);
+                }
+                OnFill(inbound_tracker.Ptr(), current_tracker.Ptr(), fill_qty, market_price_);
             }
             return fill_qty;
         }
 
-        [[nodiscard]] auto FindOnMarket(const OrderPtr &order, typename TrackerMap::iterator &result) -> bool {
-            const ComparablePrice KEY(order->IsBuy(), order->GetPrice());
-            TrackerMap &          side_map = order->IsBuy() ? bids_ : asks_;
-
-            for (result = side_map.find(KEY); result != side_map.end(); ++result) {
-                if (result->second.Ptr() == order) {
-                    return true;
-                } else if (KEY < result->first) {
-                    result = side_map.end();
-                    return false;
-                }
+        [[nodiscard]] auto FindOnMarket(const OrderPtr &order, Handle &result) -> bool {
+            STATS_TIMER(FIND);
+            if (order->IsStop()) {
+                return WithStops(order->IsBuy(), [&](auto &stops) { return stops.Find(order, result); });
             }
-            return false;
+            return WithSides(order->IsBuy(), [&](auto &own, auto &) { return own.Find(order, result); });
         }
 
-        auto CallbackNow() -> void {
-            for (auto &cb : callbacks_) {
-                PerformCallback(cb);
+        [[nodiscard]] auto LocateOnMarket(const OrderPtr &order, Handle &handle) -> bool {
+            if (order->IsStop()) {
+                return WithStops(order->IsBuy(), [&](auto &stops) { return stops.Locate(order, handle); });
             }
-            callbacks_.clear();
+            return WithSides(order->IsBuy(), [&](auto &own, auto &) { return own.Locate(order, handle); });
         }
 
-        auto PerformCallback(TypedCallback &cb) -> void {
-            switch (cb.type_) {
-                case TypedCallback::CbType::CB_ORDER_FILL:
-                    OnFill(cb.order_, cb.matched_order_, cb.quantity_);
-                    break;
-                case TypedCallback::CbType::CB_ORDER_ACCEPT:
-                    OnAccept(cb.order_);
-                    break;
-                case TypedCallback::CbType::CB_ORDER_CANCEL:
-                    OnCancel(cb.order_);
-                    break;
-                case TypedCallback::CbType::CB_ORDER_REPLACE:
-                    OnReplace(cb.order_, cb.delta_, cb.price_);
-                    break;
-                default: {
-                    std::stringstream msg;
-                    msg << "Unexpected callback type " << cb.type_;
-                    throw std::runtime_error(msg.str());
-                }
+        // Both sides keep per-level aggregates, so depth queries cost O(levels visited).
+        [[nodiscard]] auto GetBids() const -> const Bids & {
+            return bids_;
+        }
+
+        [[nodiscard]] auto GetAsks() const -> const Asks & {
+            return asks_;
+        }
+
+        [[nodiscard]] auto GetBuyStops() const -> const BuyStops & {
+            return buy_stops_;
+        }
+
+        [[nodiscard]] auto GetSellStops() const -> const SellStops & {
+            return sell_stops_;
+        }
+
+        // What an order on the given side for quantity would pay, or receive, sweeping the other side
+        // within limit, without touching the book. MARKET_ORDER_PRICE sweeps the whole side.
+        [[nodiscard]] auto Sweep(bool buy_side, Quantity quantity, Price limit = MARKET_ORDER_PRICE) const
+                -> SweepCost {
+            if (buy_side) {
+                return asks_.Sweep(BidSide::Limit(limit), quantity);
             }
+            return bids_.Sweep(AskSide::Limit(limit), quantity);
+        }
+
+        // Last trade price, or MARKET_ORDER_PRICE before the first trade.
+        [[nodiscard]] auto GetMarketPrice() const -> Price {
+            return market_price_;
+        }
+
+        // Fills of the last Add, Cancel or Replace, in the order they happened.
+        [[nodiscard]] auto GetFills() const -> std::span<const Fill> {
+            return fills_;
+        }
+
+        // Stops released by the last Add or Replace, in the order they entered the book.
+        [[nodiscard]] auto GetTriggered() const -> std::span<const Triggered> {
+            return triggered_;
         }
 
-        auto Log() const -> void {
-            LOG_INFO("SELL:");
-            std::map<Price, Quantity> book;
-            for (auto ask = asks_.begin(); ask != asks_.end(); ++ask) {
-                book[ask->first.GetPrice()] += ask->second.OpenQty();
+        auto GetListener() -> Listener & {
+            return listener_;
+        }
+
+        // Book dumps go through writer when one is given, otherwise straight to LOG_INFO.
+        auto Log(OutputWriter *writer = nullptr) const -> void {
+            auto print_level = [writer](const DepthLevel &level) { PrintLevel(writer, level.price_, level.quantity_); };
+            Print(writer, "SELL:");
+            asks_.ForEachLevelReverse(print_level);
+            Print(writer, "BUY:");
+            bids_.ForEachLevel(print_level);
+            if (writer) {
+                writer->Flush();
             }
-            for (auto level = book.rbegin(); level != book.rend(); ++level) {
-                LOG_INFO(level->first << ' ' << level->second);
+        }
+
+    private:
+        auto CancelOnMarket(const OrderPtr &order, bool found, Handle pos) -> void {
+            STATS_TIMER(CANCEL);
+            fills_.clear();
+            triggered_.clear();
+            Withdraw(order, found, pos);
+            Complete();
+        }
+
+        // Takes order off its side, or its stop side, without completing the operation.
+        auto Withdraw(const OrderPtr &order, bool found, Handle pos) -> void {
+            if (found && order->IsStop()) {
+                EraseStop(order, pos);
+            } else if (found) {
+                OnCancel(order, EraseOnMarket(order, pos));
+            } else {
+                LOG_DEBUG(*order << " not found");
             }
-            book.clear();
-            LOG_INFO("BUY:");
-            for (auto bid = bids_.begin(); bid != bids_.end(); ++bid) {
-                book[bid->first.GetPrice()] += bid->second.OpenQty();
+        }
+
+        auto ReplaceOnMarket(const OrderPtr &passivated_order, const OrderPtr &new_order, bool found, Handle &pos)
+                -> bool {
+            STATS_TIMER(REPLACE);
+            bool matched = false;
+            fills_.clear();
+            triggered_.clear();
+
+            if (passivated_order->IsStop()) {
+                // A parked stop was never on the book, so replacing it is a plain cancel and add.
+                if (found) {
+                    EraseStop(passivated_order, pos);
+                    matched = Place(new_order, book::OrderCondition::OC_NO_CONDITIONS, pos);
+                } else {
+                    LOG_DEBUG(*new_order << "not found");
+                }
+            } else if (passivated_order->IsBuy() != new_order->IsBuy()) {
+                if (found) {
+                    OnCancel(passivated_order, EraseOnMarket(passivated_order, pos));
+                    matched = Place(new_order, book::OrderCondition::OC_NO_CONDITIONS, pos);
+                } else {
+                    LOG_DEBUG(*new_order << "not found");
+                }
+            } else {
+                if (found) {
+                    // The passivated order keeps its old price until it is off the book.
+                    Quantity open_qty = EraseOnMarket(passivated_order, pos);
+                    OnAccept(new_order);
+                    Delta delta = static_cast<Delta>(new_order->GetQuantity()) -
+                                  static_cast<Delta>(passivated_order->GetQuantity());
+                    OnReplace(passivated_order, open_qty, delta, new_order->GetPrice());
+                    Tracker inbound(new_order, book::OrderCondition::OC_NO_CONDITIONS);
+                    matched = AddOrder(inbound, new_order->GetPrice(), pos);
+                    ReleaseStops();
+                } else {
+                    LOG_DEBUG(*new_order << "not found");
+                }
             }
-            for (auto level = book.rbegin(); level != book.rend(); ++level) {
-                LOG_INFO(level->first << ' ' << level->second);
+
+            Complete();
+            return matched;
+        }
+
+        // Add without completing the operation, so that a replace can add the new order as part of
+        // itself.
+        auto Place(const OrderPtr &order, OrderConditions conditions, Handle &handle) -> bool {
+            bool matched = false;
+            if (order->GetQuantity() <= 0) {
+                LOG_DEBUG(*order << " size must be positive");
+            } else if (order->IsStop() && !Reached(order)) {
+                order->OnAccepted();
+                handle = WithStops(order->IsBuy(), [&](auto &stops) {
+                    return stops.Insert(order->GetStopPrice(), Tracker(order, conditions));
+                });
+            } else if (order->IsStop()) {
+                matched = Trigger(order, conditions, handle);
+                ReleaseStops();
+            } else {
+                matched = Enter(Tracker(order, conditions), handle);
+                ReleaseStops();
             }
+            return matched;
         }
 
-    private:
-        auto SubmitOrder(Tracker &inbound) -> bool {
+        auto Complete() -> void {
+            STATS_TIMER(COMPLETE);
+            listener_.OnComplete(*this);
+        }
+
+        auto SubmitOrder(Tracker &inbound, Handle &handle) -> bool {
             Price order_price = inbound.Ptr()->GetPrice();
-            return AddOrder(inbound, order_price);
+            return AddOrder(inbound, order_price, handle);
         }
 
-        auto AddOrder(Tracker &inbound, Price order_price) -> bool {
-            bool      matched;
-            OrderPtr &order = inbound.Ptr();
-            if (order->IsBuy()) {
-                matched = MatchOrder(inbound, order_price, asks_);
-            } else {
-                matched = MatchOrder(inbound, order_price, bids_);
+        auto AddOrder(Tracker &inbound, Price order_price, Handle &handle) -> bool {
+            if (inbound.Ptr()->IsBuy()) {
+                return AddOrder<BidSide>(inbound, order_price, handle, bids_, asks_);
             }
+            return AddOrder<AskSide>(inbound, order_price, handle, asks_, bids_);
+        }
 
+        // An all-or-none order only matches when the contra side already holds its whole quantity
+        // within its limit, which is known before anything is touched, and never rests; with
+        // immediate or cancel this is fill or kill.
+        template <typename Traits, typename Own, typename Contra>
+        auto AddOrder(Tracker &inbound, Price order_price, Handle &handle, Own &own, Contra &contra) -> bool {
+            Price limit = Traits::Limit(order_price);
+            if (inbound.AllOrNone()) {
+                return contra.QuantityWithin(limit) >= inbound.OpenQty() && MatchOrder(inbound, limit, contra);
+            }
+            bool matched = MatchOrder(inbound, limit, contra);
             if (inbound.OpenQty() && !inbound.ImmediateOrCancel()) {
-                if (order->IsBuy()) {
-                    bids_.insert({ComparablePrice(true, order_price), inbound});
-                } else {
-                    asks_.insert({ComparablePrice(false, order_price), inbound});
-                }
+                handle = own.Insert(order_price, inbound);
             }
             return matched;
         }
 
+        // Accepts the order behind inbound and matches it, cancelling whatever an IOC or all-or-none
+        // order leaves over.
+        auto Enter(Tracker inbound, Handle &handle) -> bool {
+            OrderPtr order = inbound.Ptr();
+            OnAccept(order);
+            bool matched = SubmitOrder(inbound, handle);
+            if ((inbound.ImmediateOrCancel() || inbound.AllOrNone()) && !inbound.Filled()) {
+                OnCancel(order, 0);
+            }
+            return matched;
+        }
+
+        [[nodiscard]] auto Reached(const OrderPtr &order) const -> bool {
+            if (market_price_ == MARKET_ORDER_PRICE) {
+                return false;
+            }
+            return order->IsBuy() ? order->GetStopPrice() <= market_price_ : order->GetStopPrice() >= market_price_;
+        }
+
+        // Releases every stop the last trade price has reached, best trigger first, then looks again
+        // in case the released orders moved the price on. Stops released together are collected
+        // before any of them matches, so each pass sees one price.
+        auto ReleaseStops() -> void {
+            while (market_price_ != MARKET_ORDER_PRICE) {
+                released_.clear();
+                TakeReached(buy_stops_);
+                TakeReached(sell_stops_);
+                if (released_.empty()) {
+                    break;
+                }
+                for (Tracker &tracker : released_) {
+                    Handle handle{};
+                    Trigger(tracker.Ptr(), tracker.Conditions(), handle);
+                    triggered_.push_back(Triggered{tracker.Ptr(), handle});
+                }
+            }
+        }
+
+        // Enters a stop whose trigger has been reached, whether on arrival or on release. A stop
+        // without a limit price may not rest, so it enters as immediate or cancel.
+        auto Trigger(const OrderPtr &order, OrderConditions conditions, Handle &handle) -> bool {
+            if (order->GetPrice() == MARKET_ORDER_PRICE) {
+                conditions |= book::OrderCondition::OC_IMMEDIATE_OR_CANCEL;
+            }
+            order->OnTriggered();
+            return Enter(Tracker(order, conditions), handle);
+        }
+
+        template <typename Stops>
+        auto TakeReached(Stops &stops) -> void {
+            while (!stops.Empty() && stops.Matches(market_price_)) {
+                released_.push_back(stops.Front());
+                stops.PopFront();
+            }
+        }
+
+        // Parked stops leave without an event, as they arrived.
+        template <typename Side, typename Drop>
+        auto PurgeSide(Side &side, Drop &drop, bool parked) -> void {
+            side.EraseIf([&drop](const Tracker &tracker) { return drop(tracker.Ptr()); },
+                         [this, parked](const Tracker &tracker) {
+                             if (parked) {
+                                 tracker.Ptr()->OnCancelled();
+                             } else {
+                                 OnCancel(tracker.Ptr(), tracker.OpenQty());
+                             }
+                         });
+        }
+
+        auto EraseStop(const OrderPtr &order, Handle pos) -> void {
+            WithStops(order->IsBuy(), [pos](auto &stops) { stops.Erase(pos); });
+            order->OnCancelled();
+        }
+
+        // Calls fn(trigger index) for a stop on the given side.
+        template <typename Fn>
+        auto WithStops(bool buy_side, Fn &&fn) -> decltype(auto) {
+            if (buy_side) {
+                return fn(buy_stops_);
+            }
+            return fn(sell_stops_);
+        }
+
+        // Takes the order at pos off its side and returns the quantity it still had open.
+        auto EraseOnMarket(const OrderPtr &order, Handle pos) -> Quantity {
+            return WithSides(order->IsBuy(), [pos](auto &own, auto &) {
+                Quantity open_qty = own.At(pos).OpenQty();
+                own.Erase(pos);
+                return open_qty;
+            });
+        }
+
+        // Calls fn(own side, opposite side) for an order on the given side.
+        template <typename Fn>
+        auto WithSides(bool buy_side, Fn &&fn) -> decltype(auto) {
+            if (buy_side) {
+                return fn(bids_, asks_);
+            }
+            return fn(asks_, bids_);
+        }
+
         auto OnAccept(const OrderPtr &order) -> void {
             order->OnAccepted();
-            LOG_DEBUG("Event: Accepted: " << *order);
+            listener_.OnAccept(order);
         }
 
-        auto OnFill(const OrderPtr &order, const OrderPtr &matched_order, Quantity fill_qty) -> void {
+        auto OnFill(const OrderPtr &order, const OrderPtr &matched_order, Quantity fill_qty, Price fill_price) -> void {
             order->OnFilled(fill_qty);
             matched_order->OnFilled(fill_qty);
-
-            std::stringstream out;
-            out << "TRADE " << matched_order->GetOrderId() << ' ' << matched_order->GetPrice() << ' ' << fill_qty << ' '
-                << order->GetOrderId() << ' ' << order->GetPrice() << ' ' << fill_qty;
-            LOG_INFO(out.str());
-
-            order->AddTradeHistory(matched_order->GetOrderId());
-            matched_order->AddTradeHistory(order->GetOrderId());
+            fills_.push_back(Fill{++fill_count_, matched_order->GetOrderId(), order->GetOrderId(), fill_qty,
+                                  matched_order->GetPrice()});
+            listener_.OnFill(order, matched_order, fill_qty, fill_price);
         }
 
-        auto OnCancel(const OrderPtr &order) -> void {
+        auto OnCancel(const OrderPtr &order, Quantity open_qty) -> void {
             order->OnCancelled();
-            LOG_DEBUG("Event: Canceled: " << *order);
+            listener_.OnCancel(order, open_qty);
         }
 
-        auto OnReplace(const OrderPtr &order, Delta delta, Price new_price) -> void {
+        auto OnReplace(const OrderPtr &order, Quantity open_qty, Delta delta, Price new_price) -> void {
+            listener_.OnReplace(order, open_qty, delta, new_price);
             order->OnReplaced(delta, new_price);
-            LOG_DEBUG("Event: Replaced: " << *order);
         }
 
-        TrackerMap bids_{};
-        TrackerMap asks_{};
-        Price      market_price_{MARKET_ORDER_PRICE};
-        Callbacks  callbacks_{};
+        static auto Print(OutputWriter *writer, std::string_view text) -> void {
+            if (writer) {
+                writer->Line(text);
+            } else {
+                LOG_INFO(text);
+            }
+        }
+
+        static auto PrintLevel(OutputWriter *writer, Price price, AggregateQuantity quantity) -> void {
+            if (writer) {
+                writer->Level(price, quantity);
+            } else {
+                LOG_INFO(price << ' ' << quantity);
+            }
+        }
+
+        Bids                           bids_{};
+        Asks                           asks_{};
+        Price                          market_price_{MARKET_ORDER_PRICE};
+        BuyStops                       buy_stops_{};
+        SellStops                      sell_stops_{};
+        std::vector<Fill>              fills_{};
+        FillId                         fill_count_{0};
+        std::vector<Triggered>         triggered_{};
+        std::vector<Tracker>           released_{};
+        [[no_unique_address]] Listener listener_;
     };
 }    // namespace akuna::book
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Open-addressing map from OrderId to Value with linear probing and backward-shift deletion.
+    // Interned ids are dense, so the id itself is used as the hash and nearly every lookup is a
+    // single probe. Pointers returned by Find and TryEmplace are invalidated by the next insert.
+    template <typename Value>
+    class OrderMap {
+    public:
+        explicit OrderMap(size_t capacity = 1024) {
+            size_t slots = 16;
+            while (slots < capacity * 2) {
+                slots <<= 1;
+            }
+            slots_.resize(slots);
+        }
+
+        [[nodiscard]] auto Find(OrderId id) -> Value* {
+            Slot& slot = slots_[Probe(id)];
+            return slot.id_ == id ? &slot.value_ : nullptr;
+        }
+
+        // Starts loading the home slot of id so that a lookup shortly after does not stall on it.
+        auto Prefetch(OrderId id) const -> void {
+            __builtin_prefetch(&slots_[id & (slots_.size() - 1)]);
+        }
+
+        [[nodiscard]] auto Contains(OrderId id) const -> bool {
+            return slots_[Probe(id)].id_ == id;
+        }
+
+        auto TryEmplace(OrderId id, Value value) -> std::pair<Value*, bool> {
+            if ((size_ + 1) * 2 > slots_.size()) {
+                Grow();
+            }
+            Slot& slot = slots_[Probe(id)];
+            if (slot.id_ == id) {
+                return {&slot.value_, false};
+            }
+            slot.id_    = id;
+            slot.value_ = std::move(value);
+            ++size_;
+            return {&slot.value_, true};
+        }
+
+        auto Erase(OrderId id) -> bool {
+            size_t pos = Probe(id);
+            if (slots_[pos].id_ != id) {
+                return false;
+            }
+            EraseAt(pos);
+            return true;
+        }
+
+        // Removes id and moves its value into out with a single probe.
+        auto Extract(OrderId id, Value& out) -> bool {
+            size_t pos = Probe(id);
+            if (slots_[pos].id_ != id) {
+                return false;
+            }
+            out = std::move(slots_[pos].value_);
+            EraseAt(pos);
+            return true;
+        }
+
+        // Removes every entry for which drop(id, value) holds, rebuilding the table in one pass
+        // instead of closing up the probe chains one erase at a time. Returns how many went.
+        template <typename Drop>
+        auto EraseIf(Drop&& drop) -> size_t {
+            std::vector<Slot> slots(slots_.size());
+            slots_.swap(slots);
+            size_t before = size_;
+            size_         = 0;
+            for (auto& slot : slots) {
+                if (slot.id_ != INVALID_ORDER_ID && !drop(slot.id_, slot.value_)) {
+                    slots_[Probe(slot.id_)] = std::move(slot);
+                    ++size_;
+                }
+            }
+            return before - size_;
+        }
+
+        [[nodiscard]] auto Size() const -> size_t {
+            return size_;
+        }
+
+        template <typename Fn>
+        auto ForEach(Fn&& fn) const -> void {
+            for (const auto& slot : slots_) {
+                if (slot.id_ != INVALID_ORDER_ID) {
+                    fn(slot.id_, slot.value_);
+                }
+            }
+        }
+
+    private:
+        struct Slot {
+            OrderId id_{INVALID_ORDER_ID};
+            Value   value_{};
+        };
+
+        [[nodiscard]] auto Probe(OrderId id) const -> size_t {
+            size_t mask = slots_.size() - 1;
+            size_t pos  = id & mask;
+            while (slots_[pos].id_ != id && slots_[pos].id_ != INVALID_ORDER_ID) {
+                pos = (pos + 1) & mask;
+            }
+            return pos;
+        }
+
+        auto EraseAt(size_t hole) -> void {
+            // Pull later members of the probe chain back into the hole so lookups never need
+            // tombstones.
+            size_t mask = slots_.size() - 1;
+            for (size_t pos = (hole + 1) & mask; slots_[pos].id_ != INVALID_ORDER_ID; pos = (pos + 1) & mask) {
+                size_t home = slots_[pos].id_ & mask;
+                if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+                    slots_[hole] = std::move(slots_[pos]);
+                    hole         = pos;
+                }
+            }
+            slots_[hole] = Slot{};
+            --size_;
+        }
+
+        auto Grow() -> void {
+            std::vector<Slot> slots(slots_.size() * 2);
+            slots_.swap(slots);
+            for (auto& slot : slots) {
+                if (slot.id_ != INVALID_ORDER_ID) {
+                    slots_[Probe(slot.id_)] = std::move(slot);
+                }
+            }
+        }
+
+        std::vector<Slot> slots_{};
+        size_t            size_{0};
+    };
+}    // namespace akuna::book
@@ -1,11 +1,14 @@
 #pragma once
-#include "comparable_price.hpp"
+#include <stdexcept>
+
 #include "types.hpp"
 
 namespace akuna::book {
     template <typename OrderPtr>
     class OrderTracker {
     public:
+        OrderTracker() = default;
+
         explicit OrderTracker(const OrderPtr& order,
                               OrderConditions conditions = book::OrderCondition::OC_NO_CONDITIONS)
             : order_{order}, open_qty_{order->GetQuantity()}, conditions_{conditions} {
@@ -39,12 +42,20 @@ namespace akuna::book {
         }
 
         [[nodiscard]] auto ImmediateOrCancel() const -> bool {
-            return static_cast<OrderCondition>(conditions_) == OrderCondition::OC_IMMEDIATE_OR_CANCEL;
+            return (conditions_ & OrderCondition::OC_IMMEDIATE_OR_CANCEL) != 0;
+        }
+
+        [[nodiscard]] auto AllOrNone() const -> bool {
+            return (conditions_ & OrderCondition::OC_ALL_OR_NONE) != 0;
+        }
+
+        [[nodiscard]] auto Conditions() const -> OrderConditions {
+            return conditions_;
         }
 
     private:
         OrderPtr        order_{nullptr};
         Quantity        open_qty_{0};
-        OrderConditions conditions_;
+        OrderConditions conditions_{OrderCondition::OC_NO_CONDITIONS};
     };
 }    // namespace akuna::book
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.hpp"
+#include "types.hpp"
+
+namespace akuna::book {
+    // Moves text output off the matching thread. The producer pushes fixed-size records into an SPSC
+    // ring; a background thread formats them with std::to_chars into a large buffer and writes it
+    // out in batches. Flush blocks until everything pushed before it is written, which keeps the
+    // output byte-identical to writing synchronously. One writer serves one producing thread, and
+    // any names passed in must stay valid until they have been flushed. A writer without a stream
+    // discards everything.
+    class OutputWriter {
+    public:
+        explicit OutputWriter(std::FILE* out = stdout, size_t capacity = 1 << 16)
+            : out_{out}, ring_{capacity}, thread_{[this] { Run(); }} {
+        }
+
+        OutputWriter(const OutputWriter&) = delete;
+        auto operator=(const OutputWriter&) -> OutputWriter& = delete;
+
+        ~OutputWriter() {
+            Flush();
+            stop_.store(true, std::memory_order_release);
+            thread_.join();
+        }
+
+        // "TRADE <maker> <maker price> <qty> <taker> <taker price> <qty>"
+        auto Trade(std::string_view maker, Price maker_price, std::string_view taker, Price taker_price,
+                   Quantity quantity) -> void {
+            ring_.Push(Record{RecordType::TRADE, maker, taker, maker_price, taker_price, quantity});
+        }
+
+        // "<price> <quantity>"
+        auto Level(Price price, AggregateQuantity quantity) -> void {
+            ring_.Push(Record{RecordType::LEVEL, {}, {}, price, 0, quantity});
+        }
+
+        // A line of fixed text; text must outlive the writer, e.g. a string literal.
+        auto Line(std::string_view text) -> void {
+            ring_.Push(Record{RecordType::LINE, text});
+        }
+
+        auto Flush() -> void {
+            // Flush markers are handled in order, so the n-th one completes ticket n.
+            uint64_t ticket = ++flush_requested_;
+            ring_.Push(Record{RecordType::FLUSH});
+            while (flush_done_.load(std::memory_order_acquire) < ticket) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        static constexpr size_t BUFFER_SIZE{1 << 16};
+        static constexpr size_t DRAIN_BATCH{256};
+
+        enum class RecordType : uint8_t { TRADE, LEVEL, LINE, FLUSH };
+
+        struct Record {
+            RecordType        type_{RecordType::LINE};
+            std::string_view  name_{};
+            std::string_view  other_name_{};
+            Price             price_{0};
+            Price             other_price_{0};
+            AggregateQuantity quantity_{0};
+        };
+
+        auto Run() -> void {
+            buffer_.reserve(BUFFER_SIZE * 2);
+            uint32_t idle = 0;
+            while (true) {
+                size_t drained = ring_.Drain([this](const Record& record) { Format(record); }, DRAIN_BATCH);
+                if (drained > 0) {
+                    idle = 0;
+                } else if (stop_.load(std::memory_order_acquire)) {
+                    break;
+                } else if (++idle < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+            Write();
+            FlushStream();
+        }
+
+        auto Format(const Record& record) -> void {
+            switch (record.type_) {
+                case RecordType::TRADE:
+                    Append("TRADE ");
+                    Append(record.name_);
+                    Append(' ');
+                    AppendNumber(record.price_);
+                    Append(' ');
+                    AppendNumber(record.quantity_);
+                    Append(' ');
+                    Append(record.other_name_);
+                    Append(' ');
+                    AppendNumber(record.other_price_);
+                    Append(' ');
+                    AppendNumber(record.quantity_);
+                    Append('\n');
+                    break;
+                case RecordType::LEVEL:
+                    AppendNumber(record.price_);
+                    Append(' ');
+                    AppendNumber(record.quantity_);
+                    Append('\n');
+                    break;
+                case RecordType::LINE:
+                    Append(record.name_);
+                    Append('\n');
+                    break;
+                case RecordType::FLUSH:
+                    Write();
+                    FlushStream();
+                    flush_done_.store(flush_done_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                    return;
+            }
+            if (buffer_.size() >= BUFFER_SIZE) {
+                Write();
+            }
+        }
+
+        auto Append(std::string_view text) -> void {
+            buffer_.insert(buffer_.end(), text.begin(), text.end());
+        }
+
+        auto Append(char c) -> void {
+            buffer_.push_back(c);
+        }
+
+        auto AppendNumber(uint64_t value) -> void {
+            char digits[20];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            buffer_.insert(buffer_.end(), digits, result.ptr);
+        }
+
+        auto Write() -> void {
+            if (!buffer_.empty()) {
+                if (out_ != nullptr) {
+                    std::fwrite(buffer_.data(), 1, buffer_.size(), out_);
+                }
+                buffer_.clear();
+            }
+        }
+
+        auto FlushStream() -> void {
+            if (out_ != nullptr) {
+                std::fflush(out_);
+            }
+        }
+
+        std::FILE*            out_;
+        SpscRing<Record>      ring_;
+        std::vector<char>     buffer_{};
+        uint64_t              flush_requested_{0};
+        std::atomic<uint64_t> flush_done_{0};
+        std::atomic<bool>     stop_{false};
+        std::thread           thread_;
+    };
+}    // namespace akuna::book
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <thread>
+
+#include "command.hpp"
+#include "spsc_ring.hpp"
+
+namespace akuna::me {
+    // Runs reader on a parser thread and applies the decoded commands to market on the calling
+    // thread, which then does nothing but match. The two are joined by a bounded SPSC ring, so a
+    // slow matcher stalls the parser rather than letting input pile up. Publishing stays with the
+    // OutputWriter the market was built with, which makes three stages in all, and since commands
+    // reach the market in input order the output is the same as running sequentially.
+    //
+    // Names in the commands must stay valid while the parser keeps interning; IdInterner's arena
+    // never moves them.
+    template <typename Reader, typename MarketT>
+    auto RunPipelined(Reader& reader, MarketT& market, size_t capacity = 1 << 14) -> void {
+        constexpr size_t DRAIN_BATCH{256};
+
+        book::SpscRing<book::Command> commands{capacity};
+        std::thread                   parser{[&reader, &commands] {
+            book::Command command;
+            while (reader.Next(command)) {
+                if (command.valid_) {
+                    commands.Push(command);
+                }
+            }
+            // Invalid commands never reach the ring, so one marks the end of input.
+            command        = book::Command{};
+            command.valid_ = false;
+            commands.Push(command);
+        }};
+
+        bool done = false;
+        while (!done) {
+            size_t drained = commands.Drain(
+                    [&market, &done](const book::Command& command) {
+                        if (command.valid_) {
+                            market.Apply(command);
+                        } else {
+                            done = true;
+                        }
+                    },
+                    DRAIN_BATCH);
+            if (drained == 0) {
+                std::this_thread::yield();
+            }
+        }
+        parser.join();
+    }
+}    // namespace akuna::me
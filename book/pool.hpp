@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace akuna::book {
+    template <typename T>
+    class Pool;
+
+    // The reference count sits just ahead of the object, on the same cache line as its first fields.
+    template <typename T>
+    struct PoolSlot {
+        uint32_t     refs_{0};
+        alignas(T) std::byte storage_[sizeof(T)];
+        Pool<T>*     pool_{nullptr};
+        PoolSlot<T>* next_{nullptr};
+
+        auto Get() -> T* {
+            return std::launder(reinterpret_cast<T*>(storage_));
+        }
+    };
+
+    // Intrusive handle to an object living in a Pool. The reference count sits next to the object
+    // and is not atomic, so handles must stay on the thread that owns the pool. The object is
+    // destroyed and its slot recycled when the last handle goes away.
+    template <typename T>
+    class PoolPtr {
+    public:
+        PoolPtr() = default;
+
+        PoolPtr(std::nullptr_t) {
+        }
+
+        explicit PoolPtr(PoolSlot<T>* slot) : slot_{slot} {
+            Acquire();
+        }
+
+        PoolPtr(const PoolPtr& other) : slot_{other.slot_} {
+            Acquire();
+        }
+
+        PoolPtr(PoolPtr&& other) noexcept : slot_{std::exchange(other.slot_, nullptr)} {
+        }
+
+        ~PoolPtr() {
+            Release();
+        }
+
+        auto operator=(const PoolPtr& other) -> PoolPtr& {
+            if (slot_ != other.slot_) {
+                Release();
+                slot_ = other.slot_;
+                Acquire();
+            }
+            return *this;
+        }
+
+        auto operator=(PoolPtr&& other) noexcept -> PoolPtr& {
+            if (this != &other) {
+                Release();
+                slot_ = std::exchange(other.slot_, nullptr);
+            }
+            return *this;
+        }
+
+        auto operator->() const -> T* {
+            return slot_->Get();
+        }
+
+        auto operator*() const -> T& {
+            return *slot_->Get();
+        }
+
+        explicit operator bool() const {
+            return slot_ != nullptr;
+        }
+
+        auto operator==(const PoolPtr& rhs) const -> bool {
+            return slot_ == rhs.slot_;
+        }
+
+        auto operator!=(const PoolPtr& rhs) const -> bool {
+            return slot_ != rhs.slot_;
+        }
+
+    private:
+        auto Acquire() -> void {
+            if (slot_) {
+                ++slot_->refs_;
+            }
+        }
+
+        auto Release() -> void;
+
+        PoolSlot<T>* slot_{nullptr};
+    };
+
+    // Slab allocator for fixed-size objects. Slabs are carved into slots once and never returned to
+    // the heap individually: released slots go onto a free list and are reused by the next Create,
+    // and all slabs are freed together with the pool. Every handle must be gone before the pool is
+    // destroyed.
+    template <typename T>
+    class Pool {
+    public:
+        using Ptr = PoolPtr<T>;
+
+        explicit Pool(size_t slab_size = 4096) : slab_size_{slab_size} {
+        }
+
+        Pool(const Pool&) = delete;
+        auto operator=(const Pool&) -> Pool& = delete;
+
+        template <typename... Args>
+        auto Create(Args&&... args) -> Ptr {
+            if (free_ == nullptr) {
+                Grow();
+            }
+            PoolSlot<T>* slot = free_;
+            free_             = slot->next_;
+            new (slot->storage_) T(std::forward<Args>(args)...);
+            ++live_;
+            return Ptr{slot};
+        }
+
+        [[nodiscard]] auto Live() const -> size_t {
+            return live_;
+        }
+
+        [[nodiscard]] auto Capacity() const -> size_t {
+            return slabs_.size() * slab_size_;
+        }
+
+    private:
+        friend class PoolPtr<T>;
+
+        auto Grow() -> void {
+            slabs_.push_back(std::make_unique<PoolSlot<T>[]>(slab_size_));
+            PoolSlot<T>* slab = slabs_.back().get();
+            for (size_t i = slab_size_; i-- > 0;) {
+                slab[i].pool_ = this;
+                slab[i].next_ = free_;
+                free_         = &slab[i];
+            }
+        }
+
+        auto Release(PoolSlot<T>* slot) -> void {
+            slot->Get()->~T();
+            slot->next_ = free_;
+            free_       = slot;
+            --live_;
+        }
+
+        std::vector<std::unique_ptr<PoolSlot<T>[]>> slabs_{};
+        PoolSlot<T>*                                 free_{nullptr};
+        size_t                                       slab_size_;
+        size_t                                       live_{0};
+    };
+
+    template <typename T>
+    auto PoolPtr<T>::Release() -> void {
+        if (slot_ && --slot_->refs_ == 0) {
+            slot_->pool_->Release(slot_);
+        }
+        slot_ = nullptr;
+    }
+}    // namespace akuna::book
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "command.hpp"
+#include "market.hpp"
+#include "order_map.hpp"
+#include "output_writer.hpp"
+#include "spsc_ring.hpp"
+
+namespace akuna::me {
+    struct ShardConfig {
+        size_t     shards_{1};
+        size_t     queue_capacity_{1 << 16};
+        bool       pin_{true};       // pin shard i to cpu first_cpu_ + i, modulo the cpu count
+        size_t     first_cpu_{1};    // leaves cpu 0 to the input thread
+        std::FILE* out_{nullptr};    // each shard gets its own OutputWriter on out_ when set
+    };
+
+    // Spreads symbols over a fixed set of engine threads. Symbol s belongs to shard s % shards_; each
+    // shard owns a BasicMarket holding the books of its symbols and is fed through its own SPSC
+    // queue, so a book is only ever touched by one thread and the commands for one symbol are applied
+    // in the order they were submitted. Nothing is ordered across shards.
+    //
+    // Submit and Sync must be called from a single input thread. Modifies and cancels carry no
+    // symbol, so the input side remembers which symbol each id was added on; ids are expected to be
+    // unique across symbols.
+    template <template <typename, typename> class SideT = book::LadderSide>
+    class BasicShardedMarket {
+    public:
+        using Market = BasicMarket<SideT>;
+
+        explicit BasicShardedMarket(const ShardConfig& config) {
+            size_t cpus = std::max<size_t>(1, std::thread::hardware_concurrency());
+            shards_.reserve(config.shards_);
+            for (size_t i = 0; i < std::max<size_t>(1, config.shards_); ++i) {
+                shards_.push_back(std::make_unique<Shard>(config));
+                if (config.pin_) {
+                    Pin(shards_.back()->thread_, (config.first_cpu_ + i) % cpus);
+                }
+            }
+        }
+
+        BasicShardedMarket(const BasicShardedMarket&) = delete;
+        auto operator=(const BasicShardedMarket&) -> BasicShardedMarket& = delete;
+
+        ~BasicShardedMarket() {
+            for (auto& shard : shards_) {
+                shard->stop_.store(true, std::memory_order_release);
+            }
+            for (auto& shard : shards_) {
+                shard->thread_.join();
+            }
+        }
+
+        // Queues command for the shard owning its symbol, blocking while that queue is full.
+        auto Submit(book::Command command) -> void {
+            switch (command.msg_type_) {
+                case 'A':
+                    *symbols_.TryEmplace(command.order_id_, command.symbol_).first = command.symbol_;
+                    break;
+                case 'M':
+                case 'X': {
+                    auto symbol = symbols_.Find(command.order_id_);
+                    if (command.order_id_ == book::INVALID_ORDER_ID || symbol == nullptr) {
+                        return;
+                    }
+                    command.symbol_ = *symbol;
+                } break;
+                case 'C':
+                    if (command.group_ == 0) {
+                        break;
+                    }
+                    [[fallthrough]];
+                case 'T':
+                case 'E':
+                    // Every shard keeps its own clock and day, and a group may have orders on any of them.
+                    for (auto& shard : shards_) {
+                        shard->queue_.Push(command);
+                        ++shard->submitted_;
+                    }
+                    return;
+            }
+            Shard& shard = *shards_[command.symbol_ % shards_.size()];
+            shard.queue_.Push(command);
+            ++shard.submitted_;
+        }
+
+        // Blocks until every command submitted so far has been applied.
+        auto Sync() -> void {
+            for (auto& shard : shards_) {
+                while (shard->applied_.load(std::memory_order_acquire) < shard->submitted_) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        [[nodiscard]] auto ShardCount() const -> size_t {
+            return shards_.size();
+        }
+
+        // Only safe to look into once Sync has returned and before anything else is submitted.
+        [[nodiscard]] auto GetShard(size_t index) const -> const Market& {
+            return shards_[index]->market_;
+        }
+
+    private:
+        static constexpr size_t DRAIN_BATCH{256};
+
+        struct Shard {
+            explicit Shard(const ShardConfig& config)
+                : queue_{config.queue_capacity_},
+                  writer_{config.out_ ? std::make_unique<book::OutputWriter>(config.out_) : nullptr},
+                  market_{writer_.get()},
+                  thread_{[this] { Run(); }} {
+            }
+
+            auto Run() -> void {
+                uint32_t idle = 0;
+                while (true) {
+                    size_t drained =
+                            queue_.Drain([this](const book::Command& command) { market_.Apply(command); }, DRAIN_BATCH);
+                    if (drained > 0) {
+                        applied_.fetch_add(drained, std::memory_order_release);
+                        idle = 0;
+                    } else if (stop_.load(std::memory_order_acquire)) {
+                        break;
+                    } else if (++idle < 64) {
+                        std::this_thread::yield();
+                    } else {
+                        std::this_thread::sleep_for(std::chrono::microseconds(50));
+                    }
+                }
+            }
+
+            book::SpscRing<book::Command>        queue_;
+            std::unique_ptr<book::OutputWriter> writer_;
+            Market                               market_;
+            uint64_t                             submitted_{0};
+            std::atomic<uint64_t>                applied_{0};
+            std::atomic<bool>                    stop_{false};
+            std::thread                          thread_;
+        };
+
+        static auto Pin([[maybe_unused]] std::thread& thread, [[maybe_unused]] size_t cpu) -> void {
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+        }
+
+        std::vector<std::unique_ptr<Shard>> shards_{};
+        book::OrderMap<book::Symbol>        symbols_{};
+    };
+
+    using ShardedMarket = BasicShardedMarket<>;
+}    // namespace akuna::me
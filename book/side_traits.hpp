@@ -0,0 +1,81 @@
+#pragma once
+
+#include <limits>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Price ordering of one side of the book, fixed at compile time so that a side never tests
+    // which side it is and every price comparison is a single unsigned compare.
+    //
+    //   Rank(price)    sort key of a resting price, growing towards the better price. Market orders
+    //                  rank best.
+    //   Limit(price)   the worst price an inbound order on this side accepts. Market orders accept
+    //                  any price, which is resolved here, once per order, and never while matching.
+    //   Bound(limit)   the lowest rank on this side that an inbound order of the other side with the
+    //                  given limit trades with.
+    //   PriceOf(order) the price an order is filed under.
+    struct BidSide {
+        static constexpr bool BUY{true};
+
+        template <typename OrderPtr>
+        static auto PriceOf(const OrderPtr& order) -> Price {
+            return order->GetPrice();
+        }
+
+        static constexpr auto Limit(Price price) -> Price {
+            return price == MARKET_ORDER_PRICE ? std::numeric_limits<Price>::max() : price;
+        }
+
+        static constexpr auto Rank(Price price) -> Price {
+            return Limit(price);
+        }
+
+        static constexpr auto Bound(Price limit) -> Price {
+            return limit;
+        }
+    };
+
+    struct AskSide {
+        static constexpr bool BUY{false};
+
+        template <typename OrderPtr>
+        static auto PriceOf(const OrderPtr& order) -> Price {
+            return order->GetPrice();
+        }
+
+        // A market sell is already the lowest possible price.
+        static constexpr auto Limit(Price price) -> Price {
+            return price;
+        }
+
+        static constexpr auto Rank(Price price) -> Price {
+            return ~price;
+        }
+
+        static constexpr auto Bound(Price limit) -> Price {
+            return ~limit;
+        }
+    };
+
+    // Trigger indexes for stop orders, filed under their stop price. Buy stops trigger as the last
+    // trade price rises to them, so the lowest comes first as on the ask side; sell stops mirror
+    // them. Matches(last) on either tells whether the front stop has been reached.
+    struct BuyStopSide : AskSide {
+        static constexpr bool BUY{true};
+
+        template <typename OrderPtr>
+        static auto PriceOf(const OrderPtr& order) -> Price {
+            return order->GetStopPrice();
+        }
+    };
+
+    struct SellStopSide : BidSide {
+        static constexpr bool BUY{false};
+
+        template <typename OrderPtr>
+        static auto PriceOf(const OrderPtr& order) -> Price {
+            return order->GetStopPrice();
+        }
+    };
+}    // namespace akuna::book
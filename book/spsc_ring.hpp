@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace akuna::book {
+    constexpr size_t CACHE_LINE_SIZE{64};
+
+    // Bounded single-producer single-consumer ring. Head and tail live on separate cache lines and
+    // each side caches the other's index, so the shared lines are only touched when the cached view
+    // runs out. Capacity is rounded up to a power of two.
+    template <typename T>
+    class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            slots_.resize(size);
+            mask_ = size - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        auto operator=(const SpscRing&) -> SpscRing& = delete;
+
+        [[nodiscard]] auto TryPush(const T& value) -> bool {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ > mask_) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ > mask_) {
+                    return false;
+                }
+            }
+            slots_[tail & mask_] = value;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Blocks the producer while the ring is full.
+        auto Push(const T& value) -> void {
+            while (!TryPush(value)) {
+                std::this_thread::yield();
+            }
+        }
+
+        [[nodiscard]] auto TryPop(T& value) -> bool {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cache_) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cache_) {
+                    return false;
+                }
+            }
+            value = slots_[head & mask_];
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Hands up to max_count queued values to fn in order and releases their slots in one step.
+        template <typename Fn>
+        auto Drain(Fn&& fn, size_t max_count) -> size_t {
+            size_t head  = head_.load(std::memory_order_relaxed);
+            tail_cache_  = tail_.load(std::memory_order_acquire);
+            size_t count = std::min(tail_cache_ - head, max_count);
+            for (size_t i = 0; i < count; ++i) {
+                fn(slots_[(head + i) & mask_]);
+            }
+            head_.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        [[nodiscard]] auto Empty() const -> bool {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+    private:
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+        size_t tail_cache_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+        size_t head_cache_{0};
+        alignas(CACHE_LINE_SIZE) std::vector<T> slots_{};
+        size_t mask_{0};
+    };
+}    // namespace akuna::book
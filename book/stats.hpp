@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Hot-path instrumentation, compiled in only when AKUNA_STATS is defined (cmake -DAKUNA_STATS=ON).
+// STATS_TIMER times the rest of the enclosing scope and STATS_RECORD adds one sample, both into
+// histograms owned by the calling thread, so recording never allocates, locks or shares a cache
+// line. STATS_DUMP prints the calling thread's histograms. Without AKUNA_STATS all three expand to
+// nothing.
+#ifdef AKUNA_STATS
+#define STATS_CONCAT_(A, B) A##B
+#define STATS_CONCAT(A, B) STATS_CONCAT_(A, B)
+#define STATS_TIMER(METRIC) \
+    ::akuna::book::ScopedTimer STATS_CONCAT(stats_timer_, __LINE__) { ::akuna::book::Metric::METRIC }
+#define STATS_RECORD(METRIC, VALUE) ::akuna::book::Stats::Local().Record(::akuna::book::Metric::METRIC, VALUE)
+#define STATS_DUMP(FILE) ::akuna::book::Stats::Local().Dump(FILE)
+#else
+#define STATS_TIMER(METRIC)
+#define STATS_RECORD(METRIC, VALUE)
+#define STATS_DUMP(FILE)
+#endif
+
+namespace akuna::book {
+    // Timed stages are measured in TSC ticks; the rest are plain counts per event.
+    enum class Metric : uint8_t {
+        ADD,               // OrderBook::Add, matching included
+        MATCH,             // OrderBook::MatchOrder
+        FIND,              // OrderBook::FindOnMarket
+        CANCEL,            // OrderBook::Cancel after the order has been located
+        REPLACE,           // OrderBook::Replace after the order has been located
+        COMPLETE,          // listener OnComplete at the end of each operation
+        REMOVE,            // Market::RemoveOrder
+        LEVELS_WALKED,     // price levels reached by one match
+        ORDERS_TOUCHED,    // resting orders filled by one match
+        FIND_SCAN,         // orders compared by one FindOnMarket
+        COUNT
+    };
+
+    // Log-linear histogram in the style of HdrHistogram: values below 16 get a bucket each, and every
+    // power of two above that is split into 8 buckets, so any recorded value is reported within
+    // 12.5% using a fixed 4KB of counters.
+    class Histogram {
+    public:
+        auto Record(uint64_t value) -> void {
+            ++buckets_[Index(value)];
+            ++count_;
+            sum_ += value;
+            max_ = std::max(max_, value);
+        }
+
+        [[nodiscard]] auto Count() const -> uint64_t {
+            return count_;
+        }
+
+        [[nodiscard]] auto Mean() const -> double {
+            return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+        }
+
+        [[nodiscard]] auto Max() const -> uint64_t {
+            return max_;
+        }
+
+        // Upper bound of the bucket holding the value at rank (0..1), capped at the largest value seen.
+        [[nodiscard]] auto Percentile(double rank) const -> uint64_t {
+            auto     target = static_cast<uint64_t>(rank * static_cast<double>(count_));
+            uint64_t seen   = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += buckets_[i];
+                if (seen > target) {
+                    return std::min(UpperBound(i), max_);
+                }
+            }
+            return max_;
+        }
+
+    private:
+        static constexpr size_t LINEAR{16};
+        static constexpr size_t SUB_BUCKETS{8};
+        static constexpr size_t BUCKETS{LINEAR + (64 - 4) * SUB_BUCKETS};
+
+        [[nodiscard]] static auto Index(uint64_t value) -> size_t {
+            if (value < LINEAR) {
+                return value;
+            }
+            // The top four bits of value pick the bucket within its power of two.
+            size_t shift = std::bit_width(value) - 4;
+            return LINEAR + (shift - 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+        }
+
+        [[nodiscard]] static auto UpperBound(size_t index) -> uint64_t {
+            if (index < LINEAR) {
+                return index;
+            }
+            size_t   shift = (index - LINEAR) / SUB_BUCKETS + 1;
+            uint64_t top   = (index - LINEAR) % SUB_BUCKETS + SUB_BUCKETS;
+            return ((top + 1) << shift) - 1;
+        }
+
+        std::array<uint64_t, BUCKETS> buckets_{};
+        uint64_t                      count_{0};
+        uint64_t                      sum_{0};
+        uint64_t                      max_{0};
+    };
+
+    // One histogram per Metric. Each thread records into its own instance; Dump reports the calling
+    // thread's, which is the matching thread for STATS commands.
+    class Stats {
+    public:
+        static auto Local() -> Stats& {
+            thread_local Stats stats;
+            return stats;
+        }
+
+        static auto Now() -> uint64_t {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        auto Record(Metric metric, uint64_t value) -> void {
+            histograms_[static_cast<size_t>(metric)].Record(value);
+        }
+
+        auto Dump(std::FILE* out) const -> void {
+            static constexpr const char* NAMES[] = {"add",           "match",          "find",     "cancel",
+                                                    "replace",       "complete",       "remove",   "levels_walked",
+                                                    "orders_touched", "find_scan"};
+            static_assert(std::size(NAMES) == static_cast<size_t>(Metric::COUNT));
+
+            std::fprintf(out, "%-15s %12s %10s %8s %8s %8s %10s\n", "STATS", "count", "mean", "p50", "p99", "p99.9",
+                         "max");
+            for (size_t i = 0; i < histograms_.size(); ++i) {
+                const Histogram& histogram = histograms_[i];
+                if (histogram.Count() == 0) {
+                    continue;
+                }
+                std::fprintf(out, "%-15s %12lu %10.1f %8lu %8lu %8lu %10lu\n", NAMES[i], histogram.Count(),
+                             histogram.Mean(), histogram.Percentile(0.50), histogram.Percentile(0.99),
+                             histogram.Percentile(0.999), histogram.Max());
+            }
+            std::fflush(out);
+        }
+
+    private:
+        std::array<Histogram, static_cast<size_t>(Metric::COUNT)> histograms_{};
+    };
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Metric metric) : metric_{metric}, start_{Stats::Now()} {
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        auto operator=(const ScopedTimer&) -> ScopedTimer& = delete;
+
+        ~ScopedTimer() {
+            Stats::Local().Record(metric_, Stats::Now() - start_);
+        }
+
+    private:
+        Metric   metric_;
+        uint64_t start_;
+    };
+}    // namespace akuna::book
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace akuna::book {
+    // Hierarchical timer wheel over 64-bit timestamps: LEVELS wheels of SLOTS slots, one per byte of
+    // the timestamp. A timer sits on the level of the highest byte in which its expiry differs from
+    // the current time, in the slot given by that byte, so every level only ever holds timers ahead
+    // of the clock and the lowest occupied level holds the earliest ones. Advancing the clock jumps
+    // straight to the next occupied slot through a per-level occupancy bitmap and redistributes its
+    // timers onto lower levels, firing those that are due. Each timer moves down at most LEVELS
+    // times, so advancing costs O(timers fired) however far the clock moves.
+    template <typename T>
+    class TimerWheel {
+    public:
+        [[nodiscard]] auto Now() const -> Timestamp {
+            return now_;
+        }
+
+        [[nodiscard]] auto Size() const -> size_t {
+            return size_;
+        }
+
+        // expiry must be later than Now().
+        auto Schedule(Timestamp expiry, const T& value) -> void {
+            Place(Entry{expiry, value});
+            ++size_;
+        }
+
+        // Moves the clock forward to now, calling fn(expiry, value) for every timer that expires by
+        // then, earliest first. A clock that would go backwards stays where it is.
+        template <typename Fn>
+        auto Advance(Timestamp now, Fn&& fn) -> void {
+            while (now_ < now) {
+                size_t level = 0;
+                while (level < LEVELS && !Occupied(level)) {
+                    ++level;
+                }
+                if (level == LEVELS) {
+                    now_ = now;
+                    break;
+                }
+                size_t    slot  = FirstSlot(level);
+                size_t    shift = level * BITS;
+                Timestamp start = (now_ >> shift >> BITS << BITS | slot) << shift;
+                if (start > now) {
+                    now_ = now;
+                    break;
+                }
+                now_ = start;
+                pending_.swap(slots_[level][slot]);
+                occupied_[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+                for (const Entry& entry : pending_) {
+                    if (entry.expiry_ == now_) {
+                        --size_;
+                        fn(entry.expiry_, entry.value_);
+                    } else {
+                        Place(entry);
+                    }
+                }
+                pending_.clear();
+            }
+        }
+
+    private:
+        static constexpr size_t BITS{8};
+        static constexpr size_t SLOTS{size_t{1} << BITS};
+        static constexpr size_t LEVELS{64 / BITS};
+
+        struct Entry {
+            Timestamp expiry_;
+            T         value_;
+        };
+
+        auto Place(const Entry& entry) -> void {
+            size_t level = (std::bit_width(entry.expiry_ ^ now_) - 1) / BITS;
+            size_t slot  = (entry.expiry_ >> (level * BITS)) & (SLOTS - 1);
+            slots_[level][slot].push_back(entry);
+            occupied_[level][slot / 64] |= uint64_t{1} << (slot % 64);
+        }
+
+        [[nodiscard]] auto Occupied(size_t level) const -> bool {
+            for (uint64_t word : occupied_[level]) {
+                if (word != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        [[nodiscard]] auto FirstSlot(size_t level) const -> size_t {
+            size_t word = 0;
+            while (occupied_[level][word] == 0) {
+                ++word;
+            }
+            return word * 64 + static_cast<size_t>(std::countr_zero(occupied_[level][word]));
+        }
+
+        std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots_{};
+        std::array<std::array<uint64_t, SLOTS / 64>, LEVELS>      occupied_{};
+        std::vector<Entry>                                        pending_{};
+        Timestamp                                                 now_{0};
+        size_t                                                    size_{0};
+    };
+}    // namespace akuna::book
@@ -1,16 +1,30 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace akuna::book {
-    using Price           = std::size_t;
-    using Quantity        = std::size_t;
-    using Cost            = std::size_t;
-    using FillId          = std::size_t;
-    using OrderId         = std::string;
-    using Symbol          = std::size_t;
-    using Delta           = int64_t;
-    using OrderConditions = size_t;
+    // Prices and quantities are 32 bits wide unless AKUNA_WIDE_TYPES is defined (cmake
+    // -DAKUNA_WIDE_TYPES=ON). Prices are integers in the input's own units, so the narrow types cover
+    // every instrument whose prices and sizes fit in 32 bits; readers reject anything larger.
+    // Totals over many orders, such as the open quantity of a price level or a side, are always 64
+    // bits wide so that they cannot wrap however narrow a single order's quantity is.
+#ifdef AKUNA_WIDE_TYPES
+    using Price             = std::size_t;
+    using Quantity          = std::size_t;
+#else
+    using Price             = uint32_t;
+    using Quantity          = uint32_t;
+#endif
+    using AggregateQuantity = uint64_t;
+    using Cost              = std::size_t;
+    using FillId            = std::size_t;
+    using OrderId           = uint32_t;
+    using Symbol            = std::size_t;
+    using Delta             = int64_t;
+    using OrderConditions   = uint32_t;
+    using Timestamp         = uint64_t;    // in the input's own units
+    using Group             = uint32_t;    // owner or session tag; 0 for none
 
     enum OrderCondition {
         OC_NO_CONDITIONS       = 0,
@@ -19,9 +33,10 @@ namespace akuna::book {
     };
 
     namespace {
-        constexpr Price  MARKET_ORDER_PRICE{0};
-        constexpr Price  PRICE_UNCHANGED{0};
-        constexpr Delta  SIZE_UNCHANGED{0};
-        constexpr Symbol DEFAULT_SYMBOL{1};
+        constexpr Price   MARKET_ORDER_PRICE{0};
+        constexpr Price   PRICE_UNCHANGED{0};
+        constexpr Delta   SIZE_UNCHANGED{0};
+        constexpr Symbol  DEFAULT_SYMBOL{1};
+        constexpr OrderId INVALID_ORDER_ID{UINT32_MAX};
     }    // namespace
 }    // namespace akuna::book
\ No newline at end of file
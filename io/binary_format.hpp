@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#include "../book/command.hpp"
+
+namespace akuna::io {
+    // Layout of a binary command file, all fields little-endian:
+    //   BinaryHeader
+    //   BinaryRecord * record_count_
+    //   name table: name_count_ entries of { uint32_t length; char name[length]; } in OrderId order
+    // The name table lets a reader rebuild the exact interned ids used when the file was written.
+    struct BinaryHeader {
+        char     magic_[4]{'A', 'K', 'B', 'N'};
+        uint32_t version_{1};
+        uint64_t record_count_{0};
+        uint64_t names_offset_{0};
+        uint64_t name_count_{0};
+    };
+
+    static_assert(sizeof(BinaryHeader) == 32);
+
+    struct BinaryRecord {
+        static constexpr uint8_t BUY_FLAG{1};
+        static constexpr uint8_t IOC_FLAG{2};
+        static constexpr uint8_t AON_FLAG{4};
+
+        char          msg_type_{'\0'};
+        uint8_t       flags_{0};
+        uint16_t      reserved_{0};
+        book::OrderId order_id_{book::INVALID_ORDER_ID};
+        uint32_t      price_{0};
+        uint32_t      quantity_{0};
+
+        // Returns false when the command does not fit the 32-bit price and quantity fields, or is a
+        // stop, good-till-time or grouped order, which the record has no room for. A TIME record
+        // carries its timestamp in price_ (low half) and quantity_ (high half). A mass cancel
+        // carries its group in order_id_ and its band in price_ and quantity_, with an open-ended
+        // band stored as UINT32_MAX.
+        [[nodiscard]] static auto Encode(const book::Command& command, BinaryRecord& record) -> bool {
+            record           = BinaryRecord{};
+            record.msg_type_ = command.msg_type_;
+            if (command.msg_type_ == 'T') {
+                record.price_    = static_cast<uint32_t>(command.timestamp_);
+                record.quantity_ = static_cast<uint32_t>(command.timestamp_ >> 32);
+                return true;
+            }
+            if (command.msg_type_ == 'C') {
+                record.flags_    = command.is_buy_ ? BUY_FLAG : 0;
+                record.order_id_ = command.group_;
+                record.price_    = static_cast<uint32_t>(command.price_);
+                record.quantity_ = static_cast<uint32_t>(
+                        std::min<uint64_t>(command.high_price_, std::numeric_limits<uint32_t>::max()));
+                return command.price_ <= std::numeric_limits<uint32_t>::max();
+            }
+            if (command.stop_price_ != 0 || command.timestamp_ != 0 || command.group_ != 0 ||
+                command.price_ > std::numeric_limits<uint32_t>::max() ||
+                command.quantity_ > std::numeric_limits<uint32_t>::max()) {
+                return false;
+            }
+            record.flags_    = static_cast<uint8_t>((command.is_buy_ ? BUY_FLAG : 0) | (command.ioc_ ? IOC_FLAG : 0) |
+                                                (command.all_or_none_ ? AON_FLAG : 0));
+            record.order_id_ = command.order_id_;
+            record.price_    = static_cast<uint32_t>(command.price_);
+            record.quantity_ = static_cast<uint32_t>(command.quantity_);
+            return true;
+        }
+
+        auto Decode(book::Command& command) const -> void {
+            command              = book::Command{};
+            command.msg_type_    = msg_type_;
+            command.order_id_    = order_id_;
+            command.is_buy_      = (flags_ & BUY_FLAG) != 0;
+            command.ioc_         = (flags_ & IOC_FLAG) != 0;
+            command.all_or_none_ = (flags_ & AON_FLAG) != 0;
+            command.price_       = price_;
+            command.quantity_    = quantity_;
+            if (msg_type_ == 'T') {
+                command.price_     = 0;
+                command.quantity_  = 0;
+                command.timestamp_ = static_cast<book::Timestamp>(quantity_) << 32 | price_;
+            }
+            if (msg_type_ == 'C') {
+                command.order_id_   = book::INVALID_ORDER_ID;
+                command.quantity_   = 0;
+                command.group_      = order_id_;
+                command.high_price_ = quantity_ == std::numeric_limits<uint32_t>::max()
+                                              ? std::numeric_limits<book::Price>::max()
+                                              : quantity_;
+            }
+        }
+    };
+
+    static_assert(sizeof(BinaryRecord) == 16);
+
+    [[nodiscard]] inline auto IsBinaryCommandFile(std::string_view data) -> bool {
+        BinaryHeader expected;
+        return data.size() >= sizeof(BinaryHeader) && std::memcmp(data.data(), expected.magic_, 4) == 0;
+    }
+}    // namespace akuna::io
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../book/command.hpp"
+#include "../book/id_interner.hpp"
+#include "binary_format.hpp"
+
+namespace akuna::io {
+    // Streams BinaryRecords out of a memory-mapped command file. The name table is interned up
+    // front; an empty interner hands out the ids the records were written with, while one that
+    // already holds names, e.g. from a snapshot or journal, may hand out others, and the records' ids
+    // are then mapped onto them as they are read. Records are decoded with a fixed-size copy each.
+    class BinaryReader {
+    public:
+        BinaryReader(std::string_view data, book::IdInterner& ids) : ids_{ids} {
+            if (!IsBinaryCommandFile(data)) {
+                return;
+            }
+            BinaryHeader header;
+            std::memcpy(&header, data.data(), sizeof(header));
+            size_t records_end = sizeof(header) + header.record_count_ * sizeof(BinaryRecord);
+            if (header.version_ != 1 || records_end > data.size() || header.names_offset_ < records_end ||
+                header.names_offset_ > data.size()) {
+                return;
+            }
+
+            std::string_view           names = data.substr(header.names_offset_);
+            std::vector<book::OrderId> remap;
+            bool                       identity = true;
+            for (uint64_t i = 0; i < header.name_count_; ++i) {
+                uint32_t length = 0;
+                if (names.size() < sizeof(length)) {
+                    return;
+                }
+                std::memcpy(&length, names.data(), sizeof(length));
+                names.remove_prefix(sizeof(length));
+                if (names.size() < length) {
+                    return;
+                }
+                book::OrderId id = ids.Intern(names.substr(0, length));
+                identity         = identity && id == i;
+                remap.push_back(id);
+                names.remove_prefix(length);
+            }
+            if (!identity) {
+                remap_ = std::move(remap);
+            }
+
+            pos_ = data.data() + sizeof(header);
+            end_ = data.data() + records_end;
+        }
+
+        [[nodiscard]] auto Next(book::Command& command) -> bool {
+            if (pos_ >= end_) {
+                return false;
+            }
+            BinaryRecord record;
+            std::memcpy(&record, pos_, sizeof(record));
+            record.Decode(command);
+            if (command.order_id_ < remap_.size()) {
+                command.order_id_ = remap_[command.order_id_];
+            }
+            if ((command.msg_type_ == 'A' || command.msg_type_ == 'M') && command.order_id_ < ids_.Size()) {
+                command.name_ = ids_.Name(command.order_id_);
+            }
+            pos_ += sizeof(record);
+            return true;
+        }
+
+    private:
+        const book::IdInterner&    ids_;
+        std::vector<book::OrderId> remap_{};
+        const char*                pos_{nullptr};
+        const char*                end_{nullptr};
+    };
+}    // namespace akuna::io
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include "../book/command.hpp"
+#include "../book/id_interner.hpp"
+#include "binary_format.hpp"
+
+namespace akuna::io {
+    // Writes a binary command file. Records are appended as they come; Close writes the name table
+    // from the interner that produced the ids and patches the header.
+    class BinaryWriter {
+    public:
+        explicit BinaryWriter(const std::string& path) : out_{path, std::ios::binary | std::ios::trunc} {
+            WriteHeader();
+        }
+
+        [[nodiscard]] auto IsOpen() const -> bool {
+            return out_.good();
+        }
+
+        // Returns false when the command cannot be represented in a BinaryRecord.
+        [[nodiscard]] auto Write(const book::Command& command) -> bool {
+            BinaryRecord record;
+            if (!BinaryRecord::Encode(command, record)) {
+                return false;
+            }
+            out_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            ++header_.record_count_;
+            return true;
+        }
+
+        [[nodiscard]] auto Close(const book::IdInterner& ids) -> bool {
+            header_.names_offset_ = sizeof(header_) + header_.record_count_ * sizeof(BinaryRecord);
+            header_.name_count_   = ids.Size();
+            for (size_t id = 0; id < ids.Size(); ++id) {
+                auto name   = ids.Name(static_cast<book::OrderId>(id));
+                auto length = static_cast<uint32_t>(name.size());
+                out_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                out_.write(name.data(), static_cast<std::streamsize>(name.size()));
+            }
+            out_.seekp(0);
+            WriteHeader();
+            out_.close();
+            return !out_.fail();
+        }
+
+    private:
+        auto WriteHeader() -> void {
+            out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+        }
+
+        std::ofstream out_;
+        BinaryHeader  header_{};
+    };
+}    // namespace akuna::io
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__SSE2__) && !defined(SCALAR_SCAN)
+#include <emmintrin.h>
+#endif
+
+#include "../book/command.hpp"
+#include "../book/id_interner.hpp"
+
+namespace akuna::io {
+    namespace {
+        constexpr std::string_view BUY{"BUY"};
+        constexpr std::string_view SELL{"SELL"};
+        constexpr std::string_view MODIFY{"MODIFY"};
+        constexpr std::string_view CANCEL{"CANCEL"};
+        constexpr std::string_view PRINT{"PRINT"};
+        constexpr std::string_view STATS{"STATS"};
+        constexpr std::string_view IOC{"IOC"};
+        constexpr std::string_view FOK{"FOK"};
+        constexpr std::string_view STOP{"STOP"};
+        constexpr std::string_view GTT{"GTT"};
+        constexpr std::string_view TIME{"TIME"};
+        constexpr std::string_view EOD{"EOD"};
+        constexpr std::string_view MASSCANCEL{"MASSCANCEL"};
+        constexpr std::string_view GROUP{"GROUP"};
+    }    // namespace
+
+    // Returns the first occurrence of byte in [begin, end), or end. Uses 16-byte SSE2 compares when
+    // available; define SCALAR_SCAN to force the memchr path.
+    inline auto FindByte(const char* begin, const char* end, char byte) -> const char* {
+#if defined(__SSE2__) && !defined(SCALAR_SCAN)
+        const __m128i NEEDLE = _mm_set1_epi8(byte);
+        while (end - begin >= 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+            int     mask  = _mm_movemask_epi8(_mm_cmpeq_epi8(block, NEEDLE));
+            if (mask != 0) {
+                return begin + __builtin_ctz(static_cast<unsigned>(mask));
+            }
+            begin += 16;
+        }
+#endif
+        const void* found = std::memchr(begin, byte, static_cast<size_t>(end - begin));
+        return found ? static_cast<const char*>(found) : end;
+    }
+
+    // Parses the leading decimal digits of field; parsing stops at the first non-digit, so a
+    // trailing '\r' is ignored the same way std::stoull ignores it.
+    inline auto ParseNumber(std::string_view field) -> uint64_t {
+        uint64_t value = 0;
+        for (char c : field) {
+            auto digit = static_cast<unsigned>(c - '0');
+            if (digit > 9) {
+                break;
+            }
+            value = value * 10 + digit;
+        }
+        return value;
+    }
+
+    // ParseNumber into a narrower field; false when the value does not fit.
+    template <typename T>
+    [[nodiscard]] inline auto ParseValue(std::string_view field, T& value) -> bool {
+        uint64_t parsed = ParseNumber(field);
+        value           = static_cast<T>(parsed);
+        return parsed <= std::numeric_limits<T>::max();
+    }
+
+    // Tokenizes the text input format in place over a memory-mapped buffer:
+    //   BUY|SELL GFD|IOC|FOK <price> <quantity> <id> [<group>]
+    //   BUY|SELL STOP <price> <quantity> <id> <stop price> [<group>]
+    //   BUY|SELL GTT <price> <quantity> <id> <expiry> [<group>]
+    //   MODIFY <id> BUY|SELL <price> <quantity>
+    //   CANCEL <id>
+    //   MASSCANCEL BUY|SELL [<low price> <high price>]
+    //   MASSCANCEL GROUP <group>
+    //   PRINT
+    //   STATS
+    //   TIME <timestamp>
+    //   EOD
+    // Fields are views into the buffer and ids go straight to the interner, so nothing is copied or
+    // allocated per line. Ids of valid new orders are interned; modify and cancel only look ids up and
+    // report INVALID_ORDER_ID for ids that were never seen.
+    class CsvReader {
+    public:
+        CsvReader(std::string_view data, book::IdInterner& ids)
+            : pos_{data.data()}, end_{data.data() + data.size()}, ids_{ids} {
+        }
+
+        // Decodes the next line into command. Returns false once the input is exhausted; lines
+        // that are not commands come back with valid_ cleared.
+        [[nodiscard]] auto Next(book::Command& command) -> bool {
+            if (pos_ >= end_) {
+                return false;
+            }
+            const char* eol = FindByte(pos_, end_, '\n');
+            Parse(std::string_view(pos_, static_cast<size_t>(eol - pos_)), command);
+            pos_ = eol + 1;
+            return true;
+        }
+
+    private:
+        class Fields {
+        public:
+            explicit Fields(std::string_view line) : line_{line} {
+            }
+
+            auto Next() -> std::string_view {
+                size_t           space = line_.find(' ');
+                std::string_view field = line_.substr(0, space);
+                line_.remove_prefix(space == std::string_view::npos ? line_.size() : space + 1);
+                return field;
+            }
+
+        private:
+            std::string_view line_;
+        };
+
+        static auto Trim(std::string_view field) -> std::string_view {
+            if (!field.empty() && field.back() == '\r') {
+                field.remove_suffix(1);
+            }
+            return field;
+        }
+
+        auto Parse(std::string_view line, book::Command& command) -> void {
+            Fields           fields{line};
+            std::string_view type = fields.Next();
+
+            command = book::Command{};
+            if (type == BUY || type == SELL) {
+                command.msg_type_          = 'A';
+                command.is_buy_            = type == BUY;
+                std::string_view condition = fields.Next();
+                command.ioc_               = condition == IOC || condition == FOK;
+                command.all_or_none_       = condition == FOK;
+                bool price_fits            = ParseValue(fields.Next(), command.price_);
+                command.valid_             = ParseValue(fields.Next(), command.quantity_) && price_fits;
+                std::string_view id        = Trim(fields.Next());
+                if (condition == STOP) {
+                    // Price 0 makes it a stop-market order; the stop price itself must be set.
+                    bool stop_fits = ParseValue(fields.Next(), command.stop_price_);
+                    command.valid_ = command.valid_ && stop_fits && command.stop_price_ != 0;
+                } else if (condition == GTT) {
+                    command.timestamp_ = ParseNumber(fields.Next());
+                    command.valid_     = command.valid_ && command.timestamp_ != 0;
+                }
+                command.valid_ = ParseValue(fields.Next(), command.group_) && command.valid_;
+                // Only orders that get entered take an id, so that replaying the journal, which
+                // skips the rest, hands out the same ids.
+                if (command.valid_) {
+                    command.order_id_ = ids_.Intern(id);
+                    command.name_     = ids_.Name(command.order_id_);
+                }
+            } else if (type == MODIFY) {
+                command.msg_type_ = 'M';
+                command.order_id_ = ids_.Find(fields.Next());
+                command.is_buy_   = fields.Next() == BUY;
+                bool price_fits   = ParseValue(fields.Next(), command.price_);
+                command.valid_    = ParseValue(fields.Next(), command.quantity_) && price_fits;
+                if (command.order_id_ != book::INVALID_ORDER_ID) {
+                    command.name_ = ids_.Name(command.order_id_);
+                }
+            } else if (type == CANCEL) {
+                command.msg_type_ = 'X';
+                command.order_id_ = ids_.Find(Trim(fields.Next()));
+            } else if (type == MASSCANCEL) {
+                command.msg_type_      = 'C';
+                std::string_view scope = Trim(fields.Next());
+                if (scope == GROUP) {
+                    command.valid_ = ParseValue(fields.Next(), command.group_) && command.group_ != 0;
+                } else {
+                    // Without a band the whole side goes.
+                    command.is_buy_      = scope == BUY;
+                    command.high_price_  = std::numeric_limits<book::Price>::max();
+                    std::string_view low = fields.Next();
+                    if (!low.empty()) {
+                        bool low_fits  = ParseValue(low, command.price_);
+                        command.valid_ = ParseValue(fields.Next(), command.high_price_) && low_fits;
+                    }
+                    command.valid_ = command.valid_ && (scope == BUY || scope == SELL) &&
+                                     command.price_ <= command.high_price_;
+                }
+            } else if (type == PRINT) {
+                command.msg_type_ = 'P';
+            } else if (type == STATS) {
+                command.msg_type_ = 'S';
+            } else if (type == TIME) {
+                command.msg_type_  = 'T';
+                command.timestamp_ = ParseNumber(fields.Next());
+            } else if (type == EOD) {
+                command.msg_type_ = 'E';
+            } else {
+                command.valid_ = false;
+            }
+        }
+
+        const char*       pos_;
+        const char*       end_;
+        book::IdInterner& ids_;
+    };
+}    // namespace akuna::io
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "../book/command.hpp"
+#include "../book/id_interner.hpp"
+
+namespace akuna::io {
+    // Layout of a journal file, all fields little-endian:
+    //   JournalHeader
+    //   { JournalRecord; char name[name_length_]; } repeated until the end of the file
+    // Every add, modify, cancel, mass cancel, clock advance and end of day that reaches the engine is
+    // appended before it is applied, whether the market accepts it or not, so replaying the journal
+    // rebuilds both the interned ids and the book exactly. Sequence numbers start at 1 and grow by one
+    // per record. Each record carries a checksum of itself and its name, so a record torn by a crash
+    // mid-append is told apart from a complete one.
+    struct JournalHeader {
+        char     magic_[4]{'A', 'K', 'J', 'N'};
+        uint32_t version_{5};
+        uint64_t reserved_{0};
+    };
+
+    static_assert(sizeof(JournalHeader) == 16);
+
+    struct JournalRecord {
+        static constexpr uint8_t BUY_FLAG{1};
+        static constexpr uint8_t IOC_FLAG{2};
+        static constexpr uint8_t AON_FLAG{4};
+
+        uint64_t      sequence_{0};
+        char          msg_type_{'\0'};
+        uint8_t       flags_{0};
+        uint16_t      reserved_{0};
+        book::OrderId order_id_{book::INVALID_ORDER_ID};
+        uint32_t      name_length_{0};
+        book::Group   group_{0};
+        uint64_t      symbol_{0};
+        uint64_t      price_{0};
+        uint64_t      quantity_{0};
+        uint64_t      stop_price_{0};
+        uint64_t      timestamp_{0};
+        uint64_t      high_price_{0};
+        uint32_t      checksum_{0};
+        uint32_t      padding_{0};
+    };
+
+    static_assert(sizeof(JournalRecord) == 80);
+
+    // FNV-1a over record, with its checksum taken as zero, followed by name.
+    [[nodiscard]] inline auto Checksum(JournalRecord record, std::string_view name) -> uint32_t {
+        record.checksum_ = 0;
+        uint32_t hash    = 2166136261U;
+        auto     mix     = [&hash](const char* data, size_t size) {
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619U;
+            }
+        };
+        mix(reinterpret_cast<const char*>(&record), sizeof(record));
+        mix(name.data(), name.size());
+        return hash;
+    }
+
+    [[nodiscard]] inline auto IsJournaled(const book::Command& command) -> bool {
+        if (!command.valid_) {
+            return false;
+        }
+        if (command.msg_type_ == 'T' || command.msg_type_ == 'E' || command.msg_type_ == 'C') {
+            return true;
+        }
+        return (command.msg_type_ == 'A' || command.msg_type_ == 'M' || command.msg_type_ == 'X') &&
+               command.order_id_ != book::INVALID_ORDER_ID;
+    }
+
+    // Appends records to a journal, creating it when missing. Records reach the file as the stream
+    // buffer fills; Flush marks a durability point.
+    class JournalWriter {
+    public:
+        // Appends after the first length bytes of the file, dropping whatever follows them, such as a
+        // record torn by a crash that JournalReader stopped short of.
+        JournalWriter(const std::string& path, uint64_t last_sequence, uint64_t length) : sequence_{last_sequence} {
+            std::error_code error;
+            if (std::filesystem::file_size(path, error) > length && !error) {
+                std::filesystem::resize_file(path, length, error);
+            }
+            out_.open(path, std::ios::binary | std::ios::app);
+            if (length == 0) {
+                JournalHeader header;
+                out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            }
+        }
+
+        [[nodiscard]] auto IsOpen() const -> bool {
+            return out_.good();
+        }
+
+        auto Append(const book::Command& command) -> void {
+            JournalRecord record;
+            record.sequence_   = ++sequence_;
+            record.msg_type_   = command.msg_type_;
+            record.flags_      = static_cast<uint8_t>((command.is_buy_ ? JournalRecord::BUY_FLAG : 0) |
+                                                   (command.ioc_ ? JournalRecord::IOC_FLAG : 0) |
+                                                   (command.all_or_none_ ? JournalRecord::AON_FLAG : 0));
+            record.order_id_   = command.order_id_;
+            record.symbol_     = command.symbol_;
+            record.price_      = command.price_;
+            record.quantity_   = command.quantity_;
+            record.stop_price_ = command.stop_price_;
+            record.timestamp_  = command.timestamp_;
+            record.high_price_ = command.high_price_;
+            record.group_      = command.group_;
+            std::string_view name = command.msg_type_ == 'A' || command.msg_type_ == 'M' ? command.name_
+                                                                                         : std::string_view{};
+            record.name_length_   = static_cast<uint32_t>(name.size());
+            record.checksum_      = Checksum(record, name);
+            out_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            out_.write(name.data(), static_cast<std::streamsize>(name.size()));
+        }
+
+        auto Flush() -> void {
+            out_.flush();
+        }
+
+        [[nodiscard]] auto Sequence() const -> uint64_t {
+            return sequence_;
+        }
+
+    private:
+        std::ofstream out_{};
+        uint64_t      sequence_;
+    };
+
+    // Streams commands back out of a journal, interning add and modify names into ids so that every
+    // record gets the id it was written with. Reading ends at the last complete record: a short or
+    // torn header or record is where the writer stopped, not an error. A record that is intact but
+    // names an id other than the one it was written with is, and Failed reports it.
+    class JournalReader {
+    public:
+        JournalReader(std::string_view data, book::IdInterner& ids) : ids_{ids} {
+            JournalHeader expected;
+            JournalHeader header;
+            if (data.size() < sizeof(header)) {
+                return;
+            }
+            std::memcpy(&header, data.data(), sizeof(header));
+            if (std::memcmp(header.magic_, expected.magic_, 4) != 0 || header.version_ != expected.version_) {
+                failed_ = true;
+                return;
+            }
+            begin_ = data.data();
+            pos_   = data.data() + sizeof(expected);
+            end_   = data.data() + data.size();
+        }
+
+        [[nodiscard]] auto Next(book::Command& command, uint64_t& sequence) -> bool {
+            JournalRecord record;
+            if (static_cast<size_t>(end_ - pos_) < sizeof(record)) {
+                return false;
+            }
+            std::memcpy(&record, pos_, sizeof(record));
+            if (static_cast<size_t>(end_ - pos_) - sizeof(record) < record.name_length_) {
+                return false;
+            }
+            std::string_view name{pos_ + sizeof(record), record.name_length_};
+            if (Checksum(record, name) != record.checksum_) {
+                return false;
+            }
+
+            command              = book::Command{};
+            command.msg_type_    = record.msg_type_;
+            command.order_id_    = record.order_id_;
+            command.is_buy_      = (record.flags_ & JournalRecord::BUY_FLAG) != 0;
+            command.ioc_         = (record.flags_ & JournalRecord::IOC_FLAG) != 0;
+            command.all_or_none_ = (record.flags_ & JournalRecord::AON_FLAG) != 0;
+            command.symbol_      = record.symbol_;
+            command.price_       = record.price_;
+            command.quantity_    = record.quantity_;
+            command.stop_price_  = record.stop_price_;
+            command.timestamp_   = record.timestamp_;
+            command.high_price_  = record.high_price_;
+            command.group_       = record.group_;
+            if (record.msg_type_ == 'A' || record.msg_type_ == 'M') {
+                if (ids_.Intern(name) != record.order_id_) {
+                    failed_ = true;
+                    return false;
+                }
+                command.name_ = ids_.Name(record.order_id_);
+            }
+            sequence = record.sequence_;
+            pos_ += sizeof(record) + record.name_length_;
+            return true;
+        }
+
+        // True when the file is not a journal of this version, or reading stopped at a record that
+        // does not match the ids interned so far.
+        [[nodiscard]] auto Failed() const -> bool {
+            return failed_;
+        }
+
+        // Bytes from the start of the file up to the end of the last record read, which is where
+        // appending should resume; 0 when not even the header is complete.
+        [[nodiscard]] auto Length() const -> uint64_t {
+            return static_cast<uint64_t>(pos_ - begin_);
+        }
+
+    private:
+        book::IdInterner& ids_;
+        const char*       begin_{nullptr};
+        const char*       pos_{nullptr};
+        const char*       end_{nullptr};
+        bool              failed_{false};
+    };
+
+    // Reader adapter that appends every journaled command to journal before handing it on, and
+    // counts them so the caller knows the sequence its state corresponds to. journal may be null.
+    template <typename Reader>
+    class JournaledReader {
+    public:
+        JournaledReader(Reader& reader, JournalWriter* journal, uint64_t sequence)
+            : reader_{reader}, journal_{journal}, sequence_{sequence} {
+        }
+
+        [[nodiscard]] auto Next(book::Command& command) -> bool {
+            if (!reader_.Next(command)) {
+                return false;
+            }
+            if (IsJournaled(command)) {
+                ++sequence_;
+                if (journal_ != nullptr) {
+                    journal_->Append(command);
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] auto Sequence() const -> uint64_t {
+            return sequence_;
+        }
+
+    private:
+        Reader&        reader_;
+        JournalWriter* journal_;
+        uint64_t       sequence_;
+    };
+}    // namespace akuna::io
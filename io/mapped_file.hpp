@@ -0,0 +1,61 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <string_view>
+
+namespace akuna::io {
+    // Read-only memory mapping of a whole file. A file that cannot be opened leaves the mapping
+    // closed and empty rather than throwing, mirroring how an unopened std::ifstream reads nothing.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return;
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) == 0) {
+                open_ = true;
+                size_ = static_cast<size_t>(info.st_size);
+                if (size_ > 0) {
+                    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (data == MAP_FAILED) {
+                        open_ = false;
+                        size_ = 0;
+                    } else {
+                        data_ = static_cast<const char*>(data);
+                        ::madvise(data, size_, MADV_SEQUENTIAL);
+                    }
+                }
+            }
+            ::close(fd);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+        ~MappedFile() {
+            if (data_ != nullptr) {
+                ::munmap(const_cast<char*>(data_), size_);
+            }
+        }
+
+        [[nodiscard]] auto IsOpen() const -> bool {
+            return open_;
+        }
+
+        [[nodiscard]] auto Data() const -> std::string_view {
+            return {data_, size_};
+        }
+
+    private:
+        const char* data_{nullptr};
+        size_t      size_{0};
+        bool        open_{false};
+    };
+}    // namespace akuna::io
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "../book/id_interner.hpp"
+#include "mapped_file.hpp"
+
+namespace akuna::io {
+    // Layout of a snapshot file, all fields little-endian:
+    //   SnapshotHeader
+    //   SnapshotOrder * order_count_
+    //   SnapshotBook * book_count_
+    //   name table: name_count_ entries of { uint32_t length; char name[length]; } in OrderId order
+    // Resting orders come first, symbol by symbol and each side in priority order, so inserting them
+    // in file order rebuilds every price level as it was. Known orders that are off the book follow
+    // by id. Then comes the last trade price of every book that has traded, by symbol, which the
+    // book's stops trigger against. The output is a pure function of engine state, so two snapshots of the same state
+    // compare equal byte for byte.
+    struct SnapshotHeader {
+        char     magic_[4]{'A', 'K', 'S', 'N'};
+        uint32_t version_{5};
+        uint64_t sequence_{0};
+        uint64_t clock_{0};
+        uint64_t order_count_{0};
+        uint64_t names_offset_{0};
+        uint64_t name_count_{0};
+        uint64_t book_count_{0};
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 56);
+
+    struct SnapshotOrder {
+        static constexpr uint8_t BUY_FLAG{1};
+        static constexpr uint8_t RESTING_FLAG{2};
+
+        book::OrderId order_id_{book::INVALID_ORDER_ID};
+        uint8_t       flags_{0};
+        uint8_t       reserved_[3]{};
+        uint64_t      symbol_{0};
+        uint64_t      price_{0};
+        uint64_t      quantity_{0};
+        uint64_t      filled_{0};
+        uint64_t      on_market_{0};
+        uint64_t      open_qty_{0};
+        uint64_t      stop_price_{0};
+        uint64_t      expiry_{0};
+        book::Group   group_{0};
+        uint32_t      padding_{0};
+    };
+
+    static_assert(sizeof(SnapshotOrder) == 80);
+
+    struct SnapshotBook {
+        uint64_t symbol_{0};
+        uint64_t market_price_{0};
+    };
+
+    static_assert(sizeof(SnapshotBook) == 16);
+
+    // Writes the state of market, the ids it was built with, and the journal sequence that state
+    // corresponds to.
+    template <typename MarketT>
+    [[nodiscard]] auto WriteSnapshot(const std::string& path, const MarketT& market, const book::IdInterner& ids,
+                                     uint64_t sequence) -> bool {
+        std::ofstream  out{path, std::ios::binary | std::ios::trunc};
+        SnapshotHeader header;
+        header.sequence_ = sequence;
+        header.clock_    = market.Clock();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        market.ForEachOrder([&](const auto& order, bool resting, book::Quantity open_qty) {
+            SnapshotOrder record;
+            record.order_id_   = order->GetOrderId();
+            record.flags_      = static_cast<uint8_t>((order->IsBuy() ? SnapshotOrder::BUY_FLAG : 0) |
+                                                  (resting ? SnapshotOrder::RESTING_FLAG : 0));
+            record.symbol_     = order->GetSymbol();
+            record.price_      = order->GetPrice();
+            record.quantity_   = order->GetQuantity();
+            record.filled_     = order->QuantityFilled();
+            record.on_market_  = order->QuantityOnMarket();
+            record.open_qty_   = open_qty;
+            record.stop_price_ = order->GetStopPrice();
+            record.expiry_     = order->GetExpiry();
+            record.group_      = order->GetGroup();
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            ++header.order_count_;
+        });
+
+        market.ForEachMarketPrice([&](book::Symbol symbol, book::Price price) {
+            SnapshotBook record;
+            record.symbol_       = symbol;
+            record.market_price_ = price;
+            out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            ++header.book_count_;
+        });
+
+        header.names_offset_ = sizeof(header) + header.order_count_ * sizeof(SnapshotOrder) +
+                               header.book_count_ * sizeof(SnapshotBook);
+        header.name_count_   = ids.Size();
+        for (size_t id = 0; id < ids.Size(); ++id) {
+            auto name   = ids.Name(static_cast<book::OrderId>(id));
+            auto length = static_cast<uint32_t>(name.size());
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        }
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        return !out.fail();
+    }
+
+    // Loads a snapshot into an empty market and interner. The file is mapped and its order array is
+    // read in place; names are interned first so every order gets back the id it was saved with.
+    template <typename MarketT>
+    [[nodiscard]] auto LoadSnapshot(const std::string& path, MarketT& market, book::IdInterner& ids,
+                                    uint64_t& sequence) -> bool {
+        MappedFile       file{path};
+        std::string_view data = file.Data();
+        SnapshotHeader   header;
+        if (data.size() < sizeof(header) || std::memcmp(data.data(), header.magic_, 4) != 0 || ids.Size() != 0) {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        size_t orders_end = sizeof(header) + header.order_count_ * sizeof(SnapshotOrder);
+        size_t books_end  = orders_end + header.book_count_ * sizeof(SnapshotBook);
+        if (header.version_ != SnapshotHeader{}.version_ || books_end > data.size() || header.names_offset_ < books_end ||
+            header.names_offset_ > data.size()) {
+            return false;
+        }
+
+        std::string_view names = data.substr(header.names_offset_);
+        for (uint64_t i = 0; i < header.name_count_; ++i) {
+            uint32_t length = 0;
+            if (names.size() < sizeof(length)) {
+                return false;
+            }
+            std::memcpy(&length, names.data(), sizeof(length));
+            names.remove_prefix(sizeof(length));
+            if (names.size() < length) {
+                return false;
+            }
+            ids.Intern(names.substr(0, length));
+            names.remove_prefix(length);
+        }
+
+        // The clock and the trade prices go first, so that restored orders are scheduled against the
+        // one and the stops among them trigger against the other.
+        market.AdvanceClock(header.clock_);
+        const char* pos = data.data() + orders_end;
+        for (uint64_t i = 0; i < header.book_count_; ++i, pos += sizeof(SnapshotBook)) {
+            SnapshotBook record;
+            std::memcpy(&record, pos, sizeof(record));
+            market.RestoreMarketPrice(record.symbol_, static_cast<book::Price>(record.market_price_));
+        }
+        pos = data.data() + sizeof(header);
+        for (uint64_t i = 0; i < header.order_count_; ++i, pos += sizeof(SnapshotOrder)) {
+            SnapshotOrder record;
+            std::memcpy(&record, pos, sizeof(record));
+            if (record.order_id_ >= ids.Size()) {
+                return false;
+            }
+            auto order = market.NewOrder(record.order_id_, ids.Name(record.order_id_),
+                                         (record.flags_ & SnapshotOrder::BUY_FLAG) != 0, record.quantity_,
+                                         record.price_, record.symbol_, record.stop_price_, record.expiry_,
+                                         record.group_);
+            order->Restore(record.filled_, record.on_market_);
+            if (!market.RestoreOrder(order, (record.flags_ & SnapshotOrder::RESTING_FLAG) != 0, record.open_qty_)) {
+                return false;
+            }
+        }
+        sequence = header.sequence_;
+        return true;
+    }
+}    // namespace akuna::io
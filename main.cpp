@@ -1,132 +1,156 @@
-#include <fstream>
-#include <ostream>
-
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "book/command.hpp"
+#include "book/feed.hpp"
+#include "book/id_interner.hpp"
 #include "book/market.hpp"
-
-namespace {
-    const std::string BUY{"BUY"};
-    const std::string SELL{"SELL"};
-    const std::string MODIFY{"MODIFY"};
-    const std::string CANCEL{"CANCEL"};
-    const std::string PRINT{"PRINT"};
-    const std::string IOC{"IOC"};
+#include "book/output_writer.hpp"
+#include "book/pipeline.hpp"
+#include "book/stats.hpp"
+#include "io/binary_format.hpp"
+#include "io/binary_reader.hpp"
+#include "io/csv_reader.hpp"
+#include "io/journal.hpp"
+#include "io/mapped_file.hpp"
+#include "io/snapshot.hpp"
+
+// Messages the market-data feed holds before a reader that has not kept up is lapped.
+static constexpr size_t FEED_CAPACITY{1 << 18};
+
+template <typename Reader>
+static void Run(Reader& reader, akuna::me::Market* market, bool pipelined) {
+    if (pipelined) {
+        akuna::me::RunPipelined(reader, *market);
+        return;
+    }
+    std::array<akuna::book::Command, 256> batch;
+    std::array<bool, 256>                 results;
+    size_t                                size = 0;
+    while (reader.Next(batch[size])) {
+        if (++size == batch.size()) {
+            market->Process(batch, results);
+            size = 0;
+        }
+    }
+    market->Process({batch.data(), size}, results);
 }
 
-struct Order {
-    bool                  valid_{true};
-    char                  msg_type_{'\0'};
-    akuna::book::OrderId  order_id_{0};
-    bool                  is_buy_{false};
-    bool                  ioc_{false};
-    akuna::book::Quantity quantity_{0};
-    akuna::book::Price    price_{0};
-
-    friend std::ostream& operator<<(std::ostream& os, const Order& order) {
-        switch (order.msg_type_) {
-            case 'A':
-                os << "msg_type : " << order.msg_type_ << " order_id : " << order.order_id_
-                   << " is_buy : " << order.is_buy_ << " ioc : " << order.ioc_ << " quantity : " << order.quantity_
-                   << " price : " << order.price_;
-                break;
-            case 'M':
-                os << "msg_type : " << order.msg_type_ << " order_id : " << order.order_id_
-                   << " is_buy : " << order.is_buy_ << " quantity : " << order.quantity_ << " price : " << order.price_;
-                break;
-            case 'X':
-                os << "msg_type : " << order.msg_type_ << " order_id : " << order.order_id_;
-                break;
+// Applies the journal records that follow sequence without producing any output, leaving sequence
+// at the last record applied and length at the end of the last complete record. A record torn by a
+// crash ends the journal there. Fails when the file is not a journal or its records do not continue
+// from sequence and the ids interned so far.
+static auto Replay(const std::string& path, akuna::me::Market* market, akuna::book::IdInterner& ids,
+                   akuna::book::OutputWriter* output, uint64_t& sequence, uint64_t& length) -> bool {
+    akuna::io::MappedFile     file(path);
+    akuna::book::OutputWriter discard(nullptr);
+    akuna::io::JournalReader  reader(file.Data(), ids);
+    akuna::book::Command      command;
+    uint64_t                  record_sequence = 0;
+    bool                      ok              = true;
+    market->SetWriter(&discard);
+    while (ok && reader.Next(command, record_sequence)) {
+        if (record_sequence > sequence) {
+            ok       = record_sequence == sequence + 1;
+            sequence = record_sequence;
+            market->Apply(command);
         }
-        return os;
     }
-};
-
-static void Trim(std::string& line) {
-    if (!line.empty() && line[line.size() - 1] == '\r')
-        line.erase(line.size() - 1);
+    discard.Flush();
+    market->SetWriter(output);
+    length = reader.Length();
+    return ok && !reader.Failed();
 }
 
-static Order ReadLine(const std::string& line) {
-    std::string        s;
-    std::istringstream iss(line);
-
-    std::getline(iss, s, ' ');
-    Order order;
-    if (s == BUY || s == SELL) {
-        order.msg_type_ = 'A';
-
-        if (s == BUY) {
-            order.is_buy_ = true;
+// Reads commands from the given file, or input.csv. Files produced by akuna_convert are recognised
+// by their header and streamed as binary records; anything else is parsed as text. With --pipeline,
+// parsing runs on its own thread ahead of matching.
+//
+// --restore loads a snapshot before anything else. --journal replays the records of the journal
+// that are newer than the restored state and then appends every new command to it, and --snapshot
+// saves the final state once the input is done. --feed publishes every book event of the run, but
+// not of the restore or replay before it, to a shared-memory market-data feed. Builds with
+// AKUNA_STATS print the matching thread's latency histograms to stderr on STATS and at exit.
+//   akuna [--pipeline] [--restore snapshot] [--journal journal] [--snapshot snapshot] [--feed name] [file]
+int32_t main(int32_t argc, char** argv) {
+    bool        pipelined = false;
+    std::string filename{"input.csv"};
+    std::string restore_path;
+    std::string journal_path;
+    std::string snapshot_path;
+    std::string feed_name;
+    for (int32_t i = 1; i < argc; ++i) {
+        std::string_view arg{argv[i]};
+        if (arg == "--pipeline") {
+            pipelined = true;
+        } else if (arg == "--restore" && i + 1 < argc) {
+            restore_path = argv[++i];
+        } else if (arg == "--journal" && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else if (arg == "--feed" && i + 1 < argc) {
+            feed_name = argv[++i];
+        } else {
+            filename = arg;
         }
+    }
 
-        std::getline(iss, s, ' ');
-        if (s == IOC) {
-            order.ioc_ = true;
+    akuna::io::MappedFile     infile(filename);
+    akuna::book::IdInterner   ids;
+    akuna::book::OutputWriter output(stdout);
+    auto                      market   = std::make_unique<akuna::me::Market>(&output);
+    uint64_t                  sequence = 0;
+    if (!restore_path.empty() && !akuna::io::LoadSnapshot(restore_path, *market, ids, sequence)) {
+        std::cerr << "cannot load snapshot " << restore_path << '\n';
+        return 1;
+    }
+    std::unique_ptr<akuna::io::JournalWriter> journal;
+    if (!journal_path.empty()) {
+        uint64_t length = 0;
+        if (!Replay(journal_path, market.get(), ids, &output, sequence, length)) {
+            std::cerr << "journal " << journal_path << " is damaged or does not follow the snapshot\n";
+            return 1;
         }
-
-        std::getline(iss, s, ' ');
-        order.price_ = std::stoull(s);
-
-        std::getline(iss, s, ' ');
-        order.quantity_ = std::stoull(s);
-
-        std::getline(iss, s, ' ');
-        order.order_id_ = std::move(s);
-        Trim(order.order_id_);
-    } else if (s == MODIFY) {
-        order.msg_type_ = 'M';
-        std::getline(iss, s, ' ');
-        order.order_id_ = std::move(s);
-
-        std::getline(iss, s, ' ');
-        if (s == BUY) {
-            order.is_buy_ = true;
+        journal = std::make_unique<akuna::io::JournalWriter>(journal_path, sequence, length);
+        if (!journal->IsOpen()) {
+            std::cerr << "cannot open journal " << journal_path << '\n';
+            return 1;
         }
-        std::getline(iss, s, ' ');
-        order.price_ = std::stoull(s);
+    }
 
-        std::getline(iss, s, ' ');
-        order.quantity_ = std::stoull(s);
-    } else if (s == CANCEL) {
-        order.msg_type_ = 'X';
-        std::getline(iss, s, ' ');
+    std::unique_ptr<akuna::book::FeedWriter> feed;
+    if (!feed_name.empty()) {
+        feed = std::make_unique<akuna::book::FeedWriter>(feed_name, FEED_CAPACITY);
+        if (!feed->IsOpen()) {
+            std::cerr << "cannot create feed " << feed_name << '\n';
+            return 1;
+        }
+        market->SetFeed(feed.get());
+    }
 
-        order.order_id_ = std::move(s);
-        Trim(order.order_id_);
-    } else if (s == PRINT) {
-        order.msg_type_ = 'P';
+    auto run = [&](auto& reader) {
+        akuna::io::JournaledReader journaled(reader, journal.get(), sequence);
+        Run(journaled, market.get(), pipelined);
+        sequence = journaled.Sequence();
+    };
+    if (akuna::io::IsBinaryCommandFile(infile.Data())) {
+        akuna::io::BinaryReader reader(infile.Data(), ids);
+        run(reader);
     } else {
-        order.valid_ = false;
+        akuna::io::CsvReader reader(infile.Data(), ids);
+        run(reader);
     }
-    return order;
-}
 
-int32_t main() {
-    std::string   line;
-    std::string   filename{"input.csv"};
-    std::ifstream infile(filename.c_str(), std::ifstream::in);
-    auto          market = std::make_unique<akuna::me::Market>();
-    while (std::getline(infile, line)) {
-        auto order = ReadLine(line);
-        if (order.valid_) {
-            switch (order.msg_type_) {
-                case 'A': {
-                    auto conditions = order.ioc_ ? akuna::book::OrderCondition::OC_IMMEDIATE_OR_CANCEL
-                                                 : akuna::book::OrderCondition::OC_NO_CONDITIONS;
-                    market->OrderEntry(std::make_shared<akuna::book::Order>(order.order_id_, order.is_buy_,
-                                                                            order.quantity_, order.price_),
-                                       conditions);
-                } break;
-                case 'M':
-                    market->OrderModify(std::make_shared<akuna::book::Order>(order.order_id_, order.is_buy_,
-                                                                             order.quantity_, order.price_));
-                    break;
-                case 'X':
-                    market->OrderCancel(order.order_id_);
-                    break;
-                case 'P':
-                    market->Log();
-                    break;
-            }
-        }
+    if (journal) {
+        journal->Flush();
     }
-}
\ No newline at end of file
+    if (!snapshot_path.empty() && !akuna::io::WriteSnapshot(snapshot_path, *market, ids, sequence)) {
+        std::cerr << "cannot write snapshot " << snapshot_path << '\n';
+        return 1;
+    }
+    STATS_DUMP(stderr);
+}
@@ -0,0 +1,41 @@
+# Runs ENGINE over INPUT cut in two at every line, saving its state after the first part and
+# restoring it before the second, and fails unless the two outputs together match EXPECTED. STATE
+# picks how: "snapshot" saves with --snapshot and restores with --restore, "journal" runs both parts
+# with --journal.
+#   cmake -DENGINE=<akuna> -DINPUT=<file.csv> -DEXPECTED=<file.expected> -DWORK_DIR=<dir>
+#         -DSTATE=snapshot|journal -P restore.cmake
+if (STATE STREQUAL "journal")
+    set(save --journal)
+    set(load --journal)
+else ()
+    set(save --snapshot)
+    set(load --restore)
+endif ()
+file(STRINGS ${INPUT} lines)
+file(READ ${EXPECTED} expected)
+file(MAKE_DIRECTORY ${WORK_DIR})
+list(LENGTH lines count)
+math(EXPR last "${count} - 1")
+foreach (cut RANGE 1 ${last})
+    list(SUBLIST lines 0 ${cut} head)
+    list(SUBLIST lines ${cut} -1 tail)
+    list(JOIN head "\n" head)
+    list(JOIN tail "\n" tail)
+    file(WRITE ${WORK_DIR}/head.csv "${head}\n")
+    file(WRITE ${WORK_DIR}/tail.csv "${tail}\n")
+    file(REMOVE ${WORK_DIR}/${STATE})
+    execute_process(COMMAND ${ENGINE} ${save} ${WORK_DIR}/${STATE} ${WORK_DIR}/head.csv
+                    OUTPUT_VARIABLE before RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${INPUT} cut at line ${cut}: saving the ${STATE} exited with ${result}")
+    endif ()
+    execute_process(COMMAND ${ENGINE} ${load} ${WORK_DIR}/${STATE} ${WORK_DIR}/tail.csv
+                    OUTPUT_VARIABLE after RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${INPUT} cut at line ${cut}: restoring the ${STATE} exited with ${result}")
+    endif ()
+    if (NOT "${before}${after}" STREQUAL expected)
+        message(FATAL_ERROR "${INPUT} cut at line ${cut}: output differs from ${EXPECTED}\n"
+                            "--- expected\n${expected}--- actual\n${before}${after}")
+    endif ()
+endforeach ()
@@ -0,0 +1,10 @@
+# Runs ENGINE over INPUT and fails unless its output matches EXPECTED byte for byte.
+#   cmake -DENGINE=<akuna> -DINPUT=<file.csv> -DEXPECTED=<file.expected> -P run.cmake
+execute_process(COMMAND ${ENGINE} ${INPUT} OUTPUT_VARIABLE actual RESULT_VARIABLE result)
+file(READ ${EXPECTED} expected)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${ENGINE} ${INPUT} exited with ${result}")
+endif ()
+if (NOT actual STREQUAL expected)
+    message(FATAL_ERROR "${INPUT}: output differs from ${EXPECTED}\n--- expected\n${expected}--- actual\n${actual}")
+endif ()
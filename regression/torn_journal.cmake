@@ -0,0 +1,31 @@
+# Tears the last record of a journal the way a crash mid-append would, and fails unless ENGINE
+# resumes from the record before it, resubmitting the lost command, and keeps the journal readable.
+#   cmake -DENGINE=<akuna> -DWORK_DIR=<dir> -P torn_journal.cmake
+function(run expected)
+    execute_process(COMMAND ${ENGINE} --journal ${WORK_DIR}/journal ${ARGN}
+                    OUTPUT_VARIABLE actual RESULT_VARIABLE result)
+    if (NOT result EQUAL 0)
+        message(FATAL_ERROR "${ENGINE} --journal ${ARGN} exited with ${result}")
+    endif ()
+    if (NOT actual STREQUAL expected)
+        message(FATAL_ERROR "${ARGN}: output differs\n--- expected\n${expected}--- actual\n${actual}")
+    endif ()
+endfunction()
+
+file(MAKE_DIRECTORY ${WORK_DIR})
+file(REMOVE ${WORK_DIR}/journal)
+file(WRITE ${WORK_DIR}/first.csv "SELL GFD 100 10 a\nBUY GFD 100 4 b\n")
+file(WRITE ${WORK_DIR}/second.csv "BUY GFD 100 4 b\nPRINT\n")
+file(WRITE ${WORK_DIR}/third.csv "PRINT\n")
+
+run("TRADE a 100 4 b 100 4\n" ${WORK_DIR}/first.csv)
+file(SIZE ${WORK_DIR}/journal size)
+math(EXPR size "${size} - 10")
+execute_process(COMMAND truncate -s ${size} ${WORK_DIR}/journal RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "cannot truncate ${WORK_DIR}/journal")
+endif ()
+# b's add was torn, so it is not replayed and the resubmitted b trades again.
+run("TRADE a 100 4 b 100 4\nSELL:\n100 6\nBUY:\n" ${WORK_DIR}/second.csv)
+# The new b went in place of the torn one rather than after it.
+run("SELL:\n100 6\nBUY:\n" ${WORK_DIR}/third.csv)
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <string>
+
+#include "../book/command.hpp"
+#include "../book/id_interner.hpp"
+#include "../io/binary_writer.hpp"
+#include "../io/csv_reader.hpp"
+#include "../io/mapped_file.hpp"
+
+// Converts a text command file into the binary command format read by akuna.
+//   akuna_convert <input.csv> <output.bin>
+int32_t main(int32_t argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <input.csv> <output.bin>\n";
+        return 1;
+    }
+
+    akuna::io::MappedFile infile(argv[1]);
+    if (!infile.IsOpen()) {
+        std::cerr << "cannot open " << argv[1] << '\n';
+        return 1;
+    }
+    akuna::io::BinaryWriter writer(argv[2]);
+    if (!writer.IsOpen()) {
+        std::cerr << "cannot create " << argv[2] << '\n';
+        return 1;
+    }
+
+    akuna::book::IdInterner ids;
+    akuna::io::CsvReader    reader(infile.Data(), ids);
+    akuna::book::Command    command;
+    size_t                  line = 0;
+    while (reader.Next(command)) {
+        ++line;
+        if (command.valid_ && !writer.Write(command)) {
+            std::cerr << "line " << line
+                      << ": stop, good-till-time or grouped order, or price or quantity does not fit in 32 bits\n";
+            return 1;
+        }
+    }
+    if (!writer.Close(ids)) {
+        std::cerr << "failed writing " << argv[2] << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+#include "../book/feed.hpp"
+#include "../book/types.hpp"
+
+using akuna::book::FeedMessage;
+using akuna::book::FeedReader;
+
+// Book rebuilt from the feed twice over: order by order from ADD, EXECUTE, CANCEL, CLEAR and REPLACE,
+// and level by level from LEVEL and CLEAR. Once the feed is complete both views must agree.
+class FeedBook {
+public:
+    auto Apply(const FeedMessage& message) -> void {
+        switch (message.msg_type_) {
+            case FeedMessage::ADD:
+            case FeedMessage::REPLACE:
+                orders_[message.order_id_] = Order{message.symbol_, message.side_, message.price_, message.quantity_};
+                break;
+            case FeedMessage::EXECUTE:
+                Reduce(message.order_id_, message.quantity_);
+                Reduce(message.other_id_, message.quantity_);
+                break;
+            case FeedMessage::CANCEL:
+                orders_.erase(message.order_id_);
+                break;
+            case FeedMessage::CLEAR: {
+                auto key = Key{message.symbol_, message.side_, message.price_};
+                std::erase_if(orders_, [&key](const auto& entry) {
+                    const Order& order = entry.second;
+                    return Key{order.symbol_, order.side_, order.price_} == key;
+                });
+                levels_.erase(key);
+            } break;
+            case FeedMessage::LEVEL: {
+                auto key = Key{message.symbol_, message.side_, message.price_};
+                if (message.quantity_ == 0) {
+                    levels_.erase(key);
+                } else {
+                    levels_[key] = message.quantity_;
+                }
+            } break;
+        }
+    }
+
+    // Prints symbol in the engine's PRINT layout, asks then bids, both from the highest price down.
+    auto Print(akuna::book::Symbol symbol) const -> void {
+        std::printf("SELL:\n");
+        for (auto it = levels_.rbegin(); it != levels_.rend(); ++it) {
+            if (std::get<0>(it->first) == symbol && std::get<1>(it->first) == FeedMessage::SELL) {
+                std::printf("%lu %lu\n", std::get<2>(it->first), it->second);
+            }
+        }
+        std::printf("BUY:\n");
+        for (auto it = levels_.rbegin(); it != levels_.rend(); ++it) {
+            if (std::get<0>(it->first) == symbol && std::get<1>(it->first) == FeedMessage::BUY) {
+                std::printf("%lu %lu\n", std::get<2>(it->first), it->second);
+            }
+        }
+    }
+
+    // Number of price levels on which the order view and the level view disagree.
+    [[nodiscard]] auto Mismatches() const -> size_t {
+        std::map<Key, uint64_t> totals;
+        for (const auto& [id, order] : orders_) {
+            if (order.quantity_ > 0) {
+                totals[Key{order.symbol_, order.side_, order.price_}] += order.quantity_;
+            }
+        }
+        size_t mismatches = 0;
+        for (const auto& [key, quantity] : totals) {
+            auto level = levels_.find(key);
+            mismatches += level == levels_.end() || level->second != quantity;
+        }
+        for (const auto& [key, quantity] : levels_) {
+            mismatches += totals.find(key) == totals.end();
+        }
+        return mismatches;
+    }
+
+    auto Clear() -> void {
+        orders_.clear();
+        levels_.clear();
+    }
+
+private:
+    using Key = std::tuple<uint64_t, char, uint64_t>;
+
+    struct Order {
+        uint64_t symbol_;
+        char     side_;
+        uint64_t price_;
+        uint64_t quantity_;
+    };
+
+    auto Reduce(akuna::book::OrderId order_id, uint64_t quantity) -> void {
+        auto order = orders_.find(order_id);
+        if (order != orders_.end()) {
+            order->second.quantity_ -= std::min(quantity, order->second.quantity_);
+            if (order->second.quantity_ == 0) {
+                orders_.erase(order);
+            }
+        }
+    }
+
+    std::unordered_map<akuna::book::OrderId, Order> orders_{};
+    std::map<Key, uint64_t>                        levels_{};
+};
+
+// Follows the market-data feed published by `akuna --feed <name>` until the engine exits, then prints
+// the rebuilt book of one symbol and checks the order view against the level view. A reader that is
+// lapped skips ahead and starts over from the levels published after the gap.
+//   akuna_feed_reader <name> [symbol]
+int32_t main(int32_t argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "usage: " << argv[0] << " <name> [symbol]\n";
+        return 1;
+    }
+    akuna::book::Symbol symbol = argc == 3 ? std::stoul(argv[2]) : akuna::book::DEFAULT_SYMBOL;
+
+    // The engine may not have created the segment yet.
+    std::unique_ptr<FeedReader> reader;
+    for (int32_t attempt = 0; attempt < 500; ++attempt) {
+        reader = std::make_unique<FeedReader>(argv[1]);
+        if (reader->IsOpen()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (!reader->IsOpen()) {
+        std::cerr << "cannot open feed " << argv[1] << '\n';
+        return 1;
+    }
+
+    FeedBook    book;
+    FeedMessage message;
+    uint64_t    received = 0;
+    uint64_t    laps     = 0;
+    bool        complete = reader->NextSequence() == 1;
+    while (true) {
+        auto status = reader->Poll(message);
+        if (status == FeedReader::Status::OK) {
+            book.Apply(message);
+            ++received;
+        } else if (status == FeedReader::Status::LAPPED) {
+            ++laps;
+            complete = false;
+            book.Clear();
+            reader->Resync();
+        } else if (reader->Closed()) {
+            // Closed is set after the last message, so one more poll tells whether anything is left.
+            if (reader->Poll(message) != FeedReader::Status::OK) {
+                break;
+            }
+            book.Apply(message);
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    book.Print(symbol);
+    std::cerr << received << " messages, " << laps << " laps";
+    if (complete) {
+        size_t mismatches = book.Mismatches();
+        std::cerr << ", " << mismatches << " levels disagree\n";
+        return mismatches == 0 ? 0 : 2;
+    }
+    std::cerr << ", joined late or lapped so the order view is partial\n";
+    return 0;
+}